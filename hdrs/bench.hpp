@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 09:12:40 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/25 09:12:40 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+#endif
+
+// Micro-benchmark harness: warm-up runs, then runs timed repetitions of
+// ops_per_run calls to func(i). ns/op comes from steady_clock, cycles/op
+// from the TSC (reference cycles, 0 where there is none), allocs/op from
+// the operator new replacement in bench.cpp. Call bench_pin_cpu() first
+// so the runs do not migrate between cores.
+struct	bench_config_t
+{
+	uint32_t	warmup_runs;
+	uint32_t	runs;
+	uint64_t	ops_per_run;
+};
+
+struct	bench_result_t
+{
+	double	ns_min;
+	double	ns_median;
+	double	ns_stddev;
+	double	cycles_median;
+	double	allocs_per_op;
+};
+
+extern std::atomic<uint64_t>	bench_allocations;
+
+bool	bench_pin_cpu(int cpu);
+void	bench_print_header();
+void	bench_print_result(const char *name, uint16_t count, const bench_result_t& result);
+
+// Keeps value alive without a store the compiler can see through
+template <typename value_t>
+static inline void	bench_keep(const value_t& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+static inline uint64_t	bench_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static inline double	bench_median(std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+	return values[values.size() / 2];
+}
+
+template <typename func_t>
+bench_result_t	bench_run(const bench_config_t& config, func_t func)
+{
+	std::vector<double>	ns(config.runs);
+	std::vector<double>	cycles(config.runs);
+	uint64_t						allocations = 0;
+	double							mean = 0.0;
+	double							variance = 0.0;
+	bench_result_t			result {};
+
+	for (uint32_t r = 0; r < config.warmup_runs + config.runs; ++r)
+	{
+		uint64_t	allocations_start = bench_allocations.load(std::memory_order_relaxed);
+		uint64_t	cycles_start = bench_cycles();
+		auto			start = std::chrono::steady_clock::now();
+
+		for (uint64_t i = 0; i < config.ops_per_run; ++i)
+		{
+			func(i);
+		}
+		std::chrono::duration<double, std::nano>	elapsed = std::chrono::steady_clock::now() - start;
+		if (r >= config.warmup_runs)
+		{
+			ns[r - config.warmup_runs] = elapsed.count() / config.ops_per_run;
+			cycles[r - config.warmup_runs] = static_cast<double>(bench_cycles() - cycles_start) / config.ops_per_run;
+			allocations += bench_allocations.load(std::memory_order_relaxed) - allocations_start;
+		}
+	}
+	for (double value : ns)
+	{
+		mean += value / config.runs;
+	}
+	for (double value : ns)
+	{
+		variance += (value - mean) * (value - mean) / config.runs;
+	}
+	result.ns_min = *std::min_element(ns.begin(), ns.end());
+	result.ns_median = bench_median(ns);
+	result.ns_stddev = std::sqrt(variance);
+	result.cycles_median = bench_median(cycles);
+	result.allocs_per_op = static_cast<double>(allocations) / (static_cast<double>(config.runs) * config.ops_per_run);
+	return result;
+}
+
+#endif // BENCH_HPP
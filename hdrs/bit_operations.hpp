@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/10 08:07:49 by blackrider        #+#    #+#             */
-/*   Updated: 2025/07/14 11:14:57 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/05 10:07:12 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,7 +17,7 @@
 
 #define BYTE_SIZE	8
 
-static void set_bit(uint8_t *data, uint16_t bit, bool state)
+static inline void set_bit(uint8_t *data, uint16_t bit, bool state)
 {
 	if (state)
 	{
@@ -29,9 +29,21 @@ static void set_bit(uint8_t *data, uint16_t bit, bool state)
 	}
 }
 
-static bool	get_bit(uint8_t data, uint16_t bit)
+static inline bool	get_bit(uint8_t data, uint16_t bit)
 {
 	return data & (1 << bit % BYTE_SIZE);
 }
 
+// Smallest power of two >= value (value > 0)
+constexpr uint32_t	next_pow2(uint32_t value, uint32_t pow = 1)
+{
+	return pow >= value ? pow : next_pow2(value, pow << 1);
+}
+
+// Bit index of a power of two
+constexpr uint8_t	log2_pow2(uint32_t pow)
+{
+	return pow <= 1 ? 0 : 1 + log2_pow2(pow >> 1);
+}
+
 #endif // BIT_OPERATIONS_HPP
\ No newline at end of file
@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/07 07:19:29 by blackrider        #+#    #+#             */
-/*   Updated: 2025/07/24 09:16:25 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/27 10:46:37 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,61 +15,215 @@
 
 #include "test.hpp" // Include the test header for P_COUNT definition
 
-#include <cstdint>
-#include <unordered_map>
-#include <mutex>
+#include "param_idx_map.hpp"
+#include "perf_scope.hpp"
 
-static std::mutex mtx_param_value;
+#include <cstdint>
+#include <atomic>
 
-// The 'count' template parameter is no longer strictly necessary for the map,
-// but we'll keep it if other parts of your code rely on it.
+// Values live in a dense slot array; p_idx_map gives the p_num -> slot
+// lookup so SharedParam does not scan the table on every message.
+// Each slot is one 64-bit atomic word holding value, number and a write
+// version, so readers never block or see a torn (p_num, p_val) pair and
+// a writer is a single store.
+// Changed slots are flagged in per-consumer dirty bitmaps; each consumer
+// drains its own channel, so change detection is O(changed).
 template <uint16_t count>
 class	ParamData
 {
+	public:
+		static const uint8_t	DIRTY_CHANNELS = 2;
+	private:
     struct param_t
     {
         uint16_t	p_num;
         uint32_t	p_val;
+        uint16_t	version;
     };
-    std::unordered_map<uint16_t, param_t> p_data;
+    static const uint16_t	DIRTY_WORDS = (count + 63) / 64;
+    std::atomic<uint64_t>	p_data[count];
+    std::atomic<uint64_t>	dirty[DIRTY_CHANNELS][DIRTY_WORDS];
+    ParamIdxMap<uint16_t, count>	p_idx_map;
     int32_t	MAX_VALUE = 99999;
+    static inline uint64_t	pack(const param_t& param)
+    {
+        return static_cast<uint64_t>(param.version) << 48
+            | static_cast<uint64_t>(param.p_num) << 32
+            | param.p_val;
+    }
+    static inline param_t	unpack(uint64_t word)
+    {
+        return { static_cast<uint16_t>(word >> 32), static_cast<uint32_t>(word), static_cast<uint16_t>(word >> 48) };
+    }
 	public:
+		ParamData();
 		void		set_param_value(uint16_t idx, uint16_t p_num, uint32_t p_val);
 		uint32_t	get_param_value(uint16_t idx) const;
 		uint16_t	get_param_num(uint16_t idx) const;
+		// bumped by every write, changed or not; wraps at 16 bits
+		uint16_t	get_param_version(uint16_t idx) const;
 		uint16_t	get_param_idx(uint16_t p_num) const;
 		uint32_t	get_param_max_value() const;
 		void		set_param_max_value(uint32_t max_val);
 		bool		is_param_max_value_ok(uint16_t idx, uint32_t setpoint_v) const;
+		void		mark_dirty(uint16_t idx);
+		bool		is_dirty(uint8_t channel) const;
+		template <typename func_t>
+		uint16_t	drain_dirty(uint8_t channel, func_t func);
 };
 
+template <uint16_t count>
+ParamData<count>::ParamData()
+{
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		p_data[i].store(0, std::memory_order_relaxed);
+	}
+	for (uint8_t channel = 0; channel < DIRTY_CHANNELS; ++channel)
+	{
+		for (uint16_t i = 0; i < DIRTY_WORDS; ++i)
+		{
+			dirty[channel][i].store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+// Writers are lock-free: the word is replaced with a CAS, so every write
+// gets its own version even with several writers on one slot, and two
+// different values never share a version. Among concurrent writers the
+// last CAS wins, as with the old mutex.
+// Renumbering a slot updates p_idx_map, which readers do not synchronise
+// with, so slot numbers should be set up before readers start.
 template <uint16_t count>
 void	ParamData<count>::set_param_value(uint16_t idx, uint16_t p_num, uint32_t p_val)
 {
-	mtx_param_value.lock();
-	p_data[idx] = { p_num, p_val };
-	mtx_param_value.unlock();
+	PERF_SCOPE("ParamData::set_param_value");
+	param_t		param;
+	uint64_t	word;
+	bool			changed = false;
+
+	if (idx < count)
+	{
+		word = p_data[idx].load(std::memory_order_relaxed);
+		param = unpack(word);
+		if (p_idx_map.find(p_num) != idx)
+		{
+			if (param.p_num != p_num && p_idx_map.find(param.p_num) == idx)
+			{
+				p_idx_map.erase(param.p_num);
+			}
+			p_idx_map.insert(p_num, idx);
+		}
+		do
+		{
+			param = unpack(word);
+			changed = param.p_num != p_num || param.p_val != p_val;
+			param.p_num = p_num;
+			param.p_val = p_val;
+			++param.version;
+		} while (!p_data[idx].compare_exchange_weak(word, pack(param), std::memory_order_release,
+			std::memory_order_relaxed));
+		if (changed)
+		{
+			mark_dirty(idx);
+		}
+	}
+}
+
+template <uint16_t count>
+void	ParamData<count>::mark_dirty(uint16_t idx)
+{
+	uint64_t	bit = 1ull << (idx % 64);
+
+	// Pairs with the seq_cst exchange in drain_dirty: a bit still seen set
+	// has not been drained yet, so the drainer will read the new value
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	for (uint8_t channel = 0; channel < DIRTY_CHANNELS; ++channel)
+	{
+		std::atomic<uint64_t>&	word = dirty[channel][idx / 64];
+
+		// Skip the locked RMW while the consumer has not drained the bit yet
+		if (!(word.load(std::memory_order_relaxed) & bit))
+		{
+			word.fetch_or(bit, std::memory_order_release);
+		}
+	}
+}
+
+template <uint16_t count>
+bool	ParamData<count>::is_dirty(uint8_t channel) const
+{
+	bool	result = false;
+
+	for (uint16_t i = 0; i < DIRTY_WORDS && channel < DIRTY_CHANNELS && !result; ++i)
+	{
+		result = dirty[channel][i].load(std::memory_order_relaxed) != 0;
+	}
+	return result;
+}
+
+// Calls func(idx) once for every slot changed since the channel's last
+// drain and returns how many there were. One consumer per channel.
+template <uint16_t count>
+template <typename func_t>
+uint16_t	ParamData<count>::drain_dirty(uint8_t channel, func_t func)
+{
+	uint16_t	drained = 0;
+	uint64_t	bits;
+
+	for (uint16_t i = 0; i < DIRTY_WORDS && channel < DIRTY_CHANNELS; ++i)
+	{
+		bits = 0;
+		if (dirty[channel][i].load(std::memory_order_relaxed))
+		{
+			bits = dirty[channel][i].exchange(0, std::memory_order_seq_cst);
+		}
+		while (bits)
+		{
+			func(static_cast<uint16_t>(i * 64 + __builtin_ctzll(bits)));
+			bits &= bits - 1;
+			++drained;
+		}
+	}
+	return drained;
 }
 
 template <uint16_t count>
 uint32_t	ParamData<count>::get_param_value(uint16_t idx) const
 {
-	auto it = p_data.find(idx);
-	if (it != p_data.end())
+	PERF_SCOPE("ParamData::get_param_value");
+	uint32_t	result = 0;
+
+	if (idx < count)
 	{
-		return it->second.p_val; // Return the found value
+		result = unpack(p_data[idx].load(std::memory_order_acquire)).p_val;
 	}
-	return 0; // Return a default value if not found
+	return result;
 }
 
 template <uint16_t count>
 uint16_t	ParamData<count>::get_param_num(uint16_t idx) const
 {
-	auto it = p_data.find(idx);
-	if (it != p_data.end()) {
-		return it->second.p_num;
+	PERF_SCOPE("ParamData::get_param_num");
+	uint16_t	result = 0;
+
+	if (idx < count)
+	{
+		result = unpack(p_data[idx].load(std::memory_order_acquire)).p_num;
+	}
+	return result;
+}
+
+template <uint16_t count>
+uint16_t	ParamData<count>::get_param_version(uint16_t idx) const
+{
+	uint16_t	result = 0;
+
+	if (idx < count)
+	{
+		result = unpack(p_data[idx].load(std::memory_order_acquire)).version;
 	}
-	return 0; // Return default value if not found
+	return result;
 }
 
 template <uint16_t count>
@@ -87,24 +241,27 @@ void	ParamData<count>::set_param_max_value(uint32_t max_val)
 template <uint16_t count>
 uint16_t	ParamData<count>::get_param_idx(uint16_t p_num) const
 {
-	for (const auto& pair : p_data)
+	PERF_SCOPE("ParamData::get_param_idx");
+	uint16_t	idx = p_idx_map.find(p_num);
+
+	// The map and the slot must agree, e.g. after a number was given to two slots
+	if (idx < count && get_param_num(idx) != p_num)
 	{
-		if (pair.second.p_num == p_num)
-		{	
-			return pair.first; // Return the index if found
-		}
+		idx = count;
 	}
-	return count; // Return count if not found, indicating an invalid index
+	return idx; // count if not found, indicating an invalid index
 }
 
 template <uint16_t count>
 bool	ParamData<count>::is_param_max_value_ok(uint16_t idx, uint32_t setpoint_v) const
 {
-	auto it = p_data.find(idx);
-	if (it != p_data.end()) {
-		return (it->second.p_val <= MAX_VALUE);
+	bool	result = false;
+
+	if (idx < count)
+	{
+		result = (get_param_value(idx) <= MAX_VALUE);
 	}
-	return false; // Return false if parameter not found
+	return result; // false if parameter not found
 }
 
 extern ParamData<P_COUNT>	*param_data;
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cluster_sim.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 14:20:11 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/24 16:05:33 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CLUSTER_SIM_HPP
+#define CLUSTER_SIM_HPP
+
+#include "shared_data.hpp"
+#include "client_server_shared_setpoint.hpp"
+#include "sim_rng.hpp"
+#include "fault_stage.hpp"
+#include "wire_codec.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// N protocol nodes in one process, on a virtual clock. Node ticks and
+// frame deliveries are events in one queue ordered by (time, sequence),
+// so nothing sleeps and a seed replays the same run exactly. Each
+// receiver's copies of a frame come from the FaultStage. SharedParam
+// reads the global param_data, which every event switches to its node.
+class ClusterSim
+{
+	public:
+		struct	config_t
+		{
+			uint16_t		nodes_count;
+			uint32_t		tick_us;				// period of every node's tick
+			uint64_t		seed;
+			uint16_t		tx_frames;			// frames per tick, as TX_FRAMES
+			tx_budget_t	tx_budget;
+			uint16_t				payload_mtu;
+			fault_config_t	faults;
+		};
+		struct	stats_t
+		{
+			uint64_t	events;
+			uint64_t	ticks;				// node ticks, summed over nodes
+			uint64_t	frames_sent;
+			uint64_t	frames_by_type[SSV_PACKED_MESSAGE + 1];	// by message_type
+			uint64_t	wire_bytes;		// encode_frame length of every frame sent
+			uint64_t	deliveries;
+		};
+		ClusterSim(const config_t& config);
+		~ClusterSim();
+		void										select_node(uint16_t node);
+		ParamData<P_COUNT>&			get_param_data(uint16_t node) { return nodes[node].param_data; }
+		SharedData<P_COUNT>&		get_shared_data(uint16_t node) { return nodes[node].shared_data; }
+		bool										post_ssrv(uint16_t node, uint16_t param_num, int32_t value);
+		void										run_until(uint64_t time_us);
+		void										run_ticks(uint64_t ticks) { run_until(now_us + ticks * config.tick_us); }
+		bool										run_until_converged(uint64_t max_time_us);
+		uint32_t								count_diffs() const;
+		uint64_t								get_time_us() const { return now_us; }
+		uint16_t								get_nodes_count() const { return config.nodes_count; }
+		const stats_t&					get_stats() const { return stats; }
+		FaultStage&							get_faults() { return faults; }
+	private:
+		enum	event_kind_t
+		{
+			EVENT_TICK,
+			EVENT_DELIVER,
+		};
+		struct	sim_node_t
+		{
+			ParamData<P_COUNT>	param_data;
+			SharedData<P_COUNT>	shared_data;
+		};
+		// Small on purpose: the heap moves these, the frame stays in its slot
+		struct	event_t
+		{
+			uint64_t	time_us;
+			uint64_t	seq;
+			uint32_t	slot;
+			uint16_t	node;
+			uint8_t		kind;
+		};
+		// Min-heap order for std::push_heap/pop_heap
+		struct	event_after_t
+		{
+			bool	operator()(const event_t& a, const event_t& b) const
+			{
+				return a.time_us > b.time_us || (a.time_us == b.time_us && a.seq > b.seq);
+			}
+		};
+		config_t								config;
+		sim_node_t							*nodes;
+		SimRng									rng;
+		FaultStage							faults;
+		uint64_t								now_us;
+		uint64_t								next_seq;
+		stats_t									stats;
+		std::vector<event_t>		events;
+		std::vector<can_data_t>	frames;				// slots shared by a frame's deliveries
+		std::vector<uint32_t>		frame_refs;
+		std::vector<uint32_t>		free_slots;
+		std::vector<can_data_t>	tx_frames;
+		void										push_event(uint64_t time_us, uint8_t kind, uint16_t node, uint32_t slot);
+		uint32_t								alloc_slot(const can_data_t& frame);
+		void										release_slot(uint32_t slot);
+		void										tick_node(uint16_t node);
+		void										broadcast(uint16_t from, const can_data_t& frame);
+		void										deliver(uint16_t node, uint32_t slot);
+};
+
+#endif // CLUSTER_SIM_HPP
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   event_loop.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/16 09:41:27 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 10:14:09 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <sys/epoll.h>
+
+// Single-threaded epoll reactor. Sockets, eventfds and timerfds are all
+// plain fds with a handler; one loop can drive one node or several.
+// Handlers run on the loop thread, stop() may be called from any thread,
+// also before run(); a stopped loop stays stopped.
+class EventLoop
+{
+	public:
+		typedef std::function<void(uint32_t events)>				handler_t;
+		typedef std::function<void(uint64_t expirations)>	timer_handler_t;
+		static const uint16_t	MAX_HANDLERS = 64;
+		static const uint16_t	MAX_EVENTS = 32;
+		EventLoop();
+		~EventLoop();
+		bool			add_fd(int fd, handler_t handler, uint32_t events = EPOLLIN);
+		bool			remove_fd(int fd);
+		int				add_timer(uint32_t period_ms, timer_handler_t handler);
+		bool			remove_timer(int timer_fd);
+		uint16_t	run_once(int timeout_ms);
+		void			run();
+		void			stop();
+		bool			is_valid() const { return epoll_fd >= 0 && wake_fd >= 0; }
+	private:
+		// A slot removed while a batch is dispatched keeps is_used until
+		// the batch ends: its handler may be the one running, and events
+		// later in the batch still carry its number
+		struct	handler_slot_t
+		{
+			int				fd;
+			bool			is_used;
+			handler_t	handler;
+		};
+		int								epoll_fd;
+		int								wake_fd;
+		std::atomic<bool>	running;
+		bool							is_dispatching;
+		bool							has_released;
+		handler_slot_t		slots[MAX_HANDLERS];
+		int								find_slot(int fd) const;
+		int								find_free_slot() const;
+		void							release_slots();
+};
+
+#endif // EVENT_LOOP_HPP
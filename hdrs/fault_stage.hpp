@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fault_stage.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 09:37:45 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/24 09:37:45 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FAULT_STAGE_HPP
+#define FAULT_STAGE_HPP
+
+#define FAULT_MAX_COPIES		2
+#define FAULT_MAX_PARTITIONS	8
+
+#include "sim_rng.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Degradation of one bus, the same for every directed link unless a link
+// delay is set. Loss follows a Gilbert-Elliott chain per link: in the
+// good state frames are lost with loss, each frame may move the link to
+// the bad state with burst_enter, where they are lost with burst_loss
+// until it leaves again with burst_exit (mean burst 1 / burst_exit).
+struct	fault_config_t
+{
+	uint32_t	latency_us;
+	uint32_t	jitter_us;			// uniform [0, jitter_us) on top of latency
+	uint32_t	reorder_us;			// window a reordered frame is held back in
+	double		loss;						// probabilities, 0 to 1
+	double		burst_enter;
+	double		burst_exit;
+	double		burst_loss;
+	double		duplicate;
+	double		reorder;
+};
+
+// Nodes first..last hear only each other from start_us until end_us
+struct	fault_partition_t
+{
+	uint64_t	start_us;
+	uint64_t	end_us;
+	uint16_t	first;
+	uint16_t	last;
+};
+
+// Decides the fate of a frame on one directed link: how many copies get
+// through and when. Pure and seeded, with no clock or socket of its own,
+// so ClusterSim drives it on virtual time and fault_relay on the real one.
+class FaultStage
+{
+	public:
+		struct	stats_t
+		{
+			uint64_t	offered;			// frames handed to route()
+			uint64_t	passed;				// frames with at least one copy through
+			uint64_t	lost;					// random loss, bursts included
+			uint64_t	burst_lost;
+			uint64_t	partitioned;
+			uint64_t	duplicated;
+			uint64_t	reordered;
+		};
+		FaultStage(uint16_t nodes_count, const fault_config_t& config, uint64_t seed);
+		bool						set_link_delay(uint16_t from, uint16_t to, uint32_t delay_us);
+		bool						add_partition(const fault_partition_t& partition);
+		bool						is_partitioned(uint16_t from, uint16_t to, uint64_t now_us) const;
+		uint16_t				route(uint16_t from, uint16_t to, uint64_t now_us, uint64_t *delays_us);
+		uint16_t				get_nodes_count() const { return nodes_count; }
+		const stats_t&	get_stats() const { return stats; }
+	private:
+		uint16_t							nodes_count;
+		fault_config_t				config;
+		SimRng								rng;
+		stats_t								stats;
+		std::vector<uint32_t>	link_delay_us;		// nodes_count x nodes_count
+		std::vector<uint8_t>	link_bad;					// Gilbert-Elliott state per link
+		fault_partition_t			partitions[FAULT_MAX_PARTITIONS];
+		uint16_t							partitions_count;
+		bool									is_lost(uint32_t link);
+};
+
+#endif // FAULT_STAGE_HPP
@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   message_view.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/20 10:15:03 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/20 16:52:38 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MESSAGE_VIEW_HPP
+#define MESSAGE_VIEW_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+// Bounds-checked in-place access to a message inside a raw payload.
+// message_t must be a packed, may_alias wire struct: alignment 1 makes
+// any offset safe, may_alias makes the cast legal. NULL when the message
+// does not fit in data_len (view) or capacity (encode).
+template <typename message_t>
+static inline const message_t	*view_message(const uint8_t *data, uint16_t data_len, uint16_t offset = 0)
+{
+	static_assert(alignof(message_t) == 1, "wire message must be packed");
+	const message_t	*result = NULL;
+
+	if (static_cast<uint32_t>(offset) + sizeof(message_t) <= data_len)
+	{
+		result = reinterpret_cast<const message_t *>(data + offset);
+	}
+	return result;
+}
+
+template <typename message_t>
+static inline message_t	*encode_message(uint8_t *data, uint16_t capacity, uint16_t offset = 0)
+{
+	static_assert(alignof(message_t) == 1, "wire message must be packed");
+	message_t	*result = NULL;
+
+	if (static_cast<uint32_t>(offset) + sizeof(message_t) <= capacity)
+	{
+		result = reinterpret_cast<message_t *>(data + offset);
+	}
+	return result;
+}
+
+#endif // MESSAGE_VIEW_HPP
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   param_idx_map.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/05 10:12:41 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/26 19:04:50 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PARAM_IDX_MAP_HPP
+#define PARAM_IDX_MAP_HPP
+
+#include "bit_operations.hpp"
+
+#include <cstdint>
+
+// param_num -> idx table. Open addressing with linear probing, kept at
+// most half full so a lookup is one or two probes in practice.
+// Empty slots hold idx == count, which is also the "not found" result.
+// erase() shifts the rest of the probe chain back instead of leaving
+// tombstones, so renumbering never fills the table.
+template <typename idx_t, uint16_t count>
+class ParamIdxMap
+{
+	public:
+		ParamIdxMap();
+		bool	insert(uint16_t p_num, idx_t idx);
+		bool	erase(uint16_t p_num);
+		idx_t	find(uint16_t p_num) const;
+		void	clear();
+	private:
+		static const uint32_t	SIZE = next_pow2(2 * count);
+		static const uint32_t	MASK = SIZE - 1;
+		static const uint8_t	HASH_SHIFT = 32 - log2_pow2(SIZE);
+		struct	slot_t
+		{
+			uint16_t	p_num;
+			idx_t			idx;
+		};
+		slot_t		slots[SIZE];
+		uint32_t	used;
+		static inline uint32_t	get_hash(uint16_t p_num)
+		{
+			// Fibonacci hashing spreads the i * step_kef numbering evenly
+			return static_cast<uint32_t>(p_num * 2654435769u) >> HASH_SHIFT;
+		}
+};
+
+template <typename idx_t, uint16_t count>
+ParamIdxMap<idx_t, count>::ParamIdxMap()
+{
+	clear();
+}
+
+template <typename idx_t, uint16_t count>
+void	ParamIdxMap<idx_t, count>::clear()
+{
+	for (uint32_t i = 0; i < SIZE; ++i)
+	{
+		slots[i].p_num = 0;
+		slots[i].idx = count;
+	}
+	used = 0;
+}
+
+template <typename idx_t, uint16_t count>
+bool	ParamIdxMap<idx_t, count>::insert(uint16_t p_num, idx_t idx)
+{
+	uint32_t	i = get_hash(p_num);
+	bool			result = false;
+
+	while (slots[i].idx != count && slots[i].p_num != p_num)
+	{
+		i = (i + 1) & MASK;
+	}
+	if (slots[i].idx != count)
+	{
+		slots[i].idx = idx;
+		result = true;
+	}
+	else if (used < SIZE - 1)
+	{
+		slots[i].p_num = p_num;
+		slots[i].idx = idx;
+		++used;
+		result = true;
+	}
+	return result;
+}
+
+template <typename idx_t, uint16_t count>
+bool	ParamIdxMap<idx_t, count>::erase(uint16_t p_num)
+{
+	uint32_t	i = get_hash(p_num);
+	uint32_t	j;
+	uint32_t	home;
+	bool			result;
+
+	while (slots[i].idx != count && slots[i].p_num != p_num)
+	{
+		i = (i + 1) & MASK;
+	}
+	result = slots[i].idx != count;
+	j = (i + 1) & MASK;
+	while (result && slots[j].idx != count)
+	{
+		// The entry at j may fill the hole at i unless its home lies in (i, j]
+		home = get_hash(slots[j].p_num);
+		if (((j - home) & MASK) >= ((j - i) & MASK))
+		{
+			slots[i] = slots[j];
+			i = j;
+		}
+		j = (j + 1) & MASK;
+	}
+	if (result)
+	{
+		slots[i].p_num = 0;
+		slots[i].idx = count;
+		--used;
+	}
+	return result;
+}
+
+template <typename idx_t, uint16_t count>
+idx_t	ParamIdxMap<idx_t, count>::find(uint16_t p_num) const
+{
+	uint32_t	i = get_hash(p_num);
+
+	while (slots[i].idx != count && slots[i].p_num != p_num)
+	{
+		i = (i + 1) & MASK;
+	}
+	return slots[i].idx;
+}
+
+#endif // PARAM_IDX_MAP_HPP
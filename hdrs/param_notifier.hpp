@@ -0,0 +1,244 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   param_notifier.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/14 09:42:18 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 09:41:52 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PARAM_NOTIFIER_HPP
+#define PARAM_NOTIFIER_HPP
+
+#include "client_server_shared_setpoint.hpp"
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Change notifications on top of a ParamData dirty channel.
+// The protocol thread calls publish() once per tick: a relaxed scan of the
+// channel and, only if something changed, one eventfd write. A consumer
+// thread waits on get_fd() and calls dispatch(), which drains the channel
+// and runs the matching subscriptions for the whole batch.
+template <uint16_t count>
+class ParamNotifier
+{
+	public:
+		typedef std::function<void(uint16_t idx, uint16_t p_num, uint32_t p_val)>	callback_t;
+		static const uint8_t	MAX_SUBSCRIPTIONS = 16;
+		ParamNotifier(ParamData<count> *param_data, uint8_t channel);
+		~ParamNotifier();
+		int				subscribe(uint16_t first_num, uint16_t last_num, callback_t callback);
+		int				subscribe_eventfd(uint16_t first_num, uint16_t last_num);
+		void			unsubscribe(int id);
+		int				get_fd() const { return wake_fd; }
+		int				get_subscription_fd(int id) const;
+		// protocol thread
+		void			publish();
+		// consumer thread
+		bool			wait(int timeout_ms);
+		uint16_t	dispatch();
+	private:
+		struct	subscription_t
+		{
+			bool				active;
+			uint16_t		first_num;
+			uint16_t		last_num;
+			callback_t	callback;
+			int					event_fd;
+			bool				fired;
+		};
+		ParamData<count>	*param_data;
+		uint8_t						channel;
+		int								wake_fd;
+		std::atomic<bool>	signaled;
+		std::mutex				mtx_subscriptions;
+		subscription_t		subscriptions[MAX_SUBSCRIPTIONS];
+		int								add_subscription(uint16_t first_num, uint16_t last_num, callback_t callback, int event_fd);
+		static inline bool	notify_fd(int fd)
+		{
+			uint64_t	one = 1;
+
+			return write(fd, &one, sizeof(one)) == sizeof(one);
+		}
+};
+
+template <uint16_t count>
+ParamNotifier<count>::ParamNotifier(ParamData<count> *param_data, uint8_t channel) : param_data(param_data),
+	channel(channel), wake_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), signaled(false)
+{
+	for (uint8_t i = 0; i < MAX_SUBSCRIPTIONS; ++i)
+	{
+		subscriptions[i] = { false, 0, 0, callback_t(), -1, false };
+	}
+}
+
+template <uint16_t count>
+ParamNotifier<count>::~ParamNotifier()
+{
+	for (uint8_t i = 0; i < MAX_SUBSCRIPTIONS; ++i)
+	{
+		unsubscribe(i);
+	}
+	if (wake_fd >= 0)
+	{
+		close(wake_fd);
+	}
+}
+
+template <uint16_t count>
+int	ParamNotifier<count>::add_subscription(uint16_t first_num, uint16_t last_num, callback_t callback, int event_fd)
+{
+	std::lock_guard<std::mutex>	lock(mtx_subscriptions);
+	int	id = -1;
+
+	for (uint8_t i = 0; i < MAX_SUBSCRIPTIONS && id < 0; ++i)
+	{
+		if (!subscriptions[i].active)
+		{
+			subscriptions[i] = { true, first_num, last_num, callback, event_fd, false };
+			id = i;
+		}
+	}
+	return id;
+}
+
+// Returns the subscription id, -1 if the table is full
+template <uint16_t count>
+int	ParamNotifier<count>::subscribe(uint16_t first_num, uint16_t last_num, callback_t callback)
+{
+	return add_subscription(first_num, last_num, callback, -1);
+}
+
+// The eventfd counts batches that touched the range; read it, then read
+// the values from ParamData. Returns the subscription id, -1 on failure.
+template <uint16_t count>
+int	ParamNotifier<count>::subscribe_eventfd(uint16_t first_num, uint16_t last_num)
+{
+	int	event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	int	id = -1;
+
+	if (event_fd >= 0)
+	{
+		id = add_subscription(first_num, last_num, callback_t(), event_fd);
+		if (id < 0)
+		{
+			close(event_fd);
+		}
+	}
+	return id;
+}
+
+template <uint16_t count>
+void	ParamNotifier<count>::unsubscribe(int id)
+{
+	std::lock_guard<std::mutex>	lock(mtx_subscriptions);
+
+	if (id >= 0 && id < MAX_SUBSCRIPTIONS && subscriptions[id].active)
+	{
+		if (subscriptions[id].event_fd >= 0)
+		{
+			close(subscriptions[id].event_fd);
+		}
+		subscriptions[id].active = false;
+		subscriptions[id].event_fd = -1;
+		subscriptions[id].callback = callback_t();
+	}
+}
+
+template <uint16_t count>
+int	ParamNotifier<count>::get_subscription_fd(int id) const
+{
+	int	result = -1;
+
+	if (id >= 0 && id < MAX_SUBSCRIPTIONS)
+	{
+		result = subscriptions[id].event_fd;
+	}
+	return result;
+}
+
+template <uint16_t count>
+void	ParamNotifier<count>::publish()
+{
+	if (!signaled.load(std::memory_order_relaxed) && param_data->is_dirty(channel))
+	{
+		if (!signaled.exchange(true, std::memory_order_acq_rel) && !notify_fd(wake_fd))
+		{
+			signaled.store(false, std::memory_order_relaxed);
+		}
+	}
+}
+
+template <uint16_t count>
+bool	ParamNotifier<count>::wait(int timeout_ms)
+{
+	pollfd	pfd = { wake_fd, POLLIN, 0 };
+
+	return poll(&pfd, 1, timeout_ms) > 0;
+}
+
+// Callbacks run on a copy of the table, outside the lock, so they may
+// subscribe or unsubscribe; one removed meanwhile can still see this batch
+template <uint16_t count>
+uint16_t	ParamNotifier<count>::dispatch()
+{
+	subscription_t	active[MAX_SUBSCRIPTIONS];
+	uint64_t				wakeups = 0;
+	uint16_t				changed;
+
+	if (read(wake_fd, &wakeups, sizeof(wakeups)) < 0)
+	{
+		wakeups = 0;
+	}
+	// Re-arm before draining so changes made meanwhile wake us again
+	signaled.store(false, std::memory_order_release);
+	mtx_subscriptions.lock();
+	for (uint8_t i = 0; i < MAX_SUBSCRIPTIONS; ++i)
+	{
+		active[i] = subscriptions[i];
+	}
+	mtx_subscriptions.unlock();
+	changed = param_data->drain_dirty(channel, [&](uint16_t idx)
+	{
+		uint16_t	p_num = param_data->get_param_num(idx);
+		uint32_t	p_val = param_data->get_param_value(idx);
+
+		for (uint8_t i = 0; i < MAX_SUBSCRIPTIONS; ++i)
+		{
+			subscription_t&	sub = active[i];
+
+			if (sub.active && p_num >= sub.first_num && p_num <= sub.last_num)
+			{
+				if (sub.callback)
+				{
+					sub.callback(idx, p_num, p_val);
+				}
+				sub.fired = true;
+			}
+		}
+	});
+	mtx_subscriptions.lock();
+	for (uint8_t i = 0; i < MAX_SUBSCRIPTIONS; ++i)
+	{
+		// Skip an eventfd closed by unsubscribe while the callbacks ran.
+		// A failed write means the counter is saturated, still readable
+		if (active[i].fired && active[i].event_fd >= 0 && subscriptions[i].active
+			&& subscriptions[i].event_fd == active[i].event_fd)
+		{
+			notify_fd(active[i].event_fd);
+		}
+	}
+	mtx_subscriptions.unlock();
+	return changed;
+}
+
+#endif // PARAM_NOTIFIER_HPP
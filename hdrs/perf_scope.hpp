@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf_scope.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 15:40:02 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/25 15:40:02 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PERF_SCOPE_HPP
+#define PERF_SCOPE_HPP
+
+#define PERF_MAX_SCOPES	32
+
+#include <cstdint>
+#include <atomic>
+#include <ostream>
+
+// Hardware counters around a block: PERF_SCOPE("name") counts cycles,
+// instructions, L1D read misses, LLC misses and branch misses from there
+// to the end of the scope and adds them to the totals of "name". Builds
+// without -DSHARED_DATA_PERF compile it to nothing. Counters are opened
+// per thread on first use and read with rdpmc where the kernel allows it,
+// so a scope costs tens of cycles, not two syscalls; scopes nest and
+// count inclusively. perf_print_report() serves the benchmarks and
+// long-running nodes alike.
+enum	perf_counter_t
+{
+	PERF_CYCLES,
+	PERF_INSTRUCTIONS,
+	PERF_L1D_MISSES,
+	PERF_LLC_MISSES,
+	PERF_BRANCH_MISSES,
+	PERF_COUNTERS,
+};
+
+#ifdef SHARED_DATA_PERF
+
+// Totals of one scope, shared by every thread that enters it
+class PerfScopeStats
+{
+	public:
+		PerfScopeStats(const char *name);
+		void				add(const uint64_t *deltas);
+		void				reset();
+		const char	*get_name() const { return name; }
+		uint64_t		get_calls() const { return calls.load(std::memory_order_relaxed); }
+		uint64_t		get_total(uint8_t counter) const { return totals[counter].load(std::memory_order_relaxed); }
+	private:
+		const char							*name;
+		std::atomic<uint64_t>		calls;
+		std::atomic<uint64_t>		totals[PERF_COUNTERS];
+};
+
+class PerfScope
+{
+	public:
+		PerfScope(PerfScopeStats& stats);
+		~PerfScope();
+	private:
+		PerfScopeStats&	stats;
+		bool						is_counting;
+		uint64_t				start[PERF_COUNTERS];
+};
+
+# define PERF_CONCAT_(a, b)	a##b
+# define PERF_CONCAT(a, b)	PERF_CONCAT_(a, b)
+# define PERF_SCOPE(name) \
+	static PerfScopeStats	PERF_CONCAT(perf_stats_, __LINE__)(name); \
+	PerfScope	PERF_CONCAT(perf_scope_, __LINE__)(PERF_CONCAT(perf_stats_, __LINE__))
+
+void	perf_print_report(std::ostream& out);
+void	perf_reset();
+
+#else
+
+# define PERF_SCOPE(name)
+
+static inline void	perf_print_report(std::ostream&) {}
+static inline void	perf_reset() {}
+
+#endif // SHARED_DATA_PERF
+
+#endif // PERF_SCOPE_HPP
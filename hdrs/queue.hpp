@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/01 07:56:22 by BlackRider        #+#    #+#             */
-/*   Updated: 2025/07/21 08:57:18 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/06 09:31:08 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,17 +14,20 @@
 #define QUEUE_HPP
 
 #include <cstdint>
+#include <type_traits>
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 class FSQueue
 {
 	private:
-		uint8_t	head;
-		uint8_t	tail;
-		uint8_t	count;
+		// Positions only need to reach size, so small queues stay byte-sized
+		typedef typename std::conditional<(size <= UINT8_MAX), uint8_t, uint16_t>::type	q_idx_t;
+		q_idx_t	head;
+		q_idx_t	tail;
+		q_idx_t	count;
 		data_t 	data[size];
-		inline void			incr_queue_param(uint8_t& param) { param = (param + 1) % size; }
-		inline uint8_t	get_queue_idx(uint8_t i) { return i % size; }
+		inline void			incr_queue_param(q_idx_t& param) { param = (param + 1) % size; }
+		inline q_idx_t	get_queue_idx(uint32_t i) { return i % size; }
 	public:
 		FSQueue() : head(0), tail(0), count(0) {}
 		bool	push(const data_t &item);
@@ -33,12 +36,12 @@ class FSQueue
 		void	swap(uint16_t swap_item);
 		bool	peek(data_t &item) const;
 		bool	peek_second(data_t &item) const;
-		uint8_t get_count() const;
+		uint16_t get_count() const;
 		bool is_empty() const;
 		bool is_full() const;
 };
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::push(const data_t &item)
 {
 	bool result = false;
@@ -53,7 +56,7 @@ bool FSQueue<data_t, size>::push(const data_t &item)
 	return result;
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::pop(data_t &item)
 {
 	bool result = false;
@@ -68,7 +71,7 @@ bool FSQueue<data_t, size>::pop(data_t &item)
 	return result;
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::pop()
 {
 	bool result = false;
@@ -82,7 +85,7 @@ bool FSQueue<data_t, size>::pop()
 	return result;
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 void FSQueue<data_t, size>::swap(uint16_t swap_item)
 {
 	data_t temp = data[head];
@@ -101,7 +104,7 @@ void FSQueue<data_t, size>::swap(uint16_t swap_item)
 	}
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::peek(data_t& item) const
 {
 	bool	result = false;
@@ -114,7 +117,7 @@ bool FSQueue<data_t, size>::peek(data_t& item) const
 	return result;
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::peek_second(data_t& item) const
 {
 	bool	result = false;
@@ -127,19 +130,19 @@ bool FSQueue<data_t, size>::peek_second(data_t& item) const
 	return result;
 }
 
-template <typename data_t, uint8_t size>
-uint8_t FSQueue<data_t, size>::get_count() const
+template <typename data_t, uint16_t size>
+uint16_t FSQueue<data_t, size>::get_count() const
 {
 	return count;
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::is_empty() const
 {
 	return (count == 0);
 }
 
-template <typename data_t, uint8_t size>
+template <typename data_t, uint16_t size>
 bool FSQueue<data_t, size>::is_full() const
 {
 	return (count == size);
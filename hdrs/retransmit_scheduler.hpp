@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   retransmit_scheduler.hpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/08 09:14:33 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/08 11:52:07 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RETRANSMIT_SCHEDULER_HPP
+#define RETRANSMIT_SCHEDULER_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+// Fixed-size binary min-heap of items keyed by the tick they are due.
+// Items due on the same tick come out in push order. Due ticks are
+// compared with wrap-around, so pending items must stay within half the
+// tick_t range of each other.
+template <typename data_t, uint16_t size, typename tick_t>
+class RetransmitScheduler
+{
+	public:
+		RetransmitScheduler() : count(0), seq(0) {}
+		bool			push(const data_t& item, tick_t due);
+		bool			pop_due(tick_t now, data_t& item);
+		bool			peek_due(tick_t& due) const;
+		uint16_t	get_count() const { return count; }
+		bool			is_empty() const { return count == 0; }
+		bool			is_full() const { return count == size; }
+	private:
+		typedef typename std::make_signed<tick_t>::type	tick_diff_t;
+		struct	entry_t
+		{
+			tick_t		due;
+			uint32_t	seq;
+			data_t		item;
+		};
+		entry_t		heap[size];
+		uint16_t	count;
+		uint32_t	seq;
+		void			sift_up(uint16_t i);
+		void			sift_down(uint16_t i);
+		static inline bool	is_before(const entry_t& a, const entry_t& b)
+		{
+			tick_diff_t	diff = static_cast<tick_diff_t>(a.due - b.due);
+
+			return diff != 0 ? diff < 0 : static_cast<int32_t>(a.seq - b.seq) < 0;
+		}
+};
+
+template <typename data_t, uint16_t size, typename tick_t>
+bool	RetransmitScheduler<data_t, size, tick_t>::push(const data_t& item, tick_t due)
+{
+	bool	result = false;
+
+	if (!is_full())
+	{
+		heap[count] = { due, seq++, item };
+		sift_up(count);
+		++count;
+		result = true;
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size, typename tick_t>
+bool	RetransmitScheduler<data_t, size, tick_t>::pop_due(tick_t now, data_t& item)
+{
+	bool	result = false;
+
+	if (!is_empty() && static_cast<tick_diff_t>(heap[0].due - now) <= 0)
+	{
+		item = heap[0].item;
+		--count;
+		if (count > 0)
+		{
+			heap[0] = heap[count];
+			sift_down(0);
+		}
+		result = true;
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size, typename tick_t>
+bool	RetransmitScheduler<data_t, size, tick_t>::peek_due(tick_t& due) const
+{
+	bool	result = false;
+
+	if (!is_empty())
+	{
+		due = heap[0].due;
+		result = true;
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size, typename tick_t>
+void	RetransmitScheduler<data_t, size, tick_t>::sift_up(uint16_t i)
+{
+	entry_t		entry = heap[i];
+	uint16_t	parent;
+
+	while (i > 0)
+	{
+		parent = (i - 1) / 2;
+		if (!is_before(entry, heap[parent]))
+		{
+			break ;
+		}
+		heap[i] = heap[parent];
+		i = parent;
+	}
+	heap[i] = entry;
+}
+
+template <typename data_t, uint16_t size, typename tick_t>
+void	RetransmitScheduler<data_t, size, tick_t>::sift_down(uint16_t i)
+{
+	entry_t		entry = heap[i];
+	uint32_t	child;
+
+	while ((child = 2 * static_cast<uint32_t>(i) + 1) < count)
+	{
+		if (child + 1 < count && is_before(heap[child + 1], heap[child]))
+		{
+			++child;
+		}
+		if (!is_before(heap[child], entry))
+		{
+			break ;
+		}
+		heap[i] = heap[child];
+		i = child;
+	}
+	heap[i] = entry;
+}
+
+#endif // RETRANSMIT_SCHEDULER_HPP
@@ -0,0 +1,241 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ring_queue.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/09 10:03:27 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/09 15:46:10 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RING_QUEUE_HPP
+#define RING_QUEUE_HPP
+
+#include "bit_operations.hpp"
+
+#include <cstdint>
+#include <atomic>
+
+#define CACHE_LINE_SIZE	64
+
+// Threading policy of a RingQueue
+enum queue_policy_t
+{
+	QUEUE_SINGLE_THREAD,	// same contract as FSQueue, no synchronisation
+	QUEUE_SPSC,						// one producer thread, one consumer thread
+	QUEUE_MPSC,						// any number of producers, one consumer thread
+};
+
+// Bounded FIFO ring. Capacity is size rounded up to a power of two so
+// positions wrap with a mask; head and tail are free-running counters
+// kept on separate cache lines.
+template <typename data_t, uint16_t size, queue_policy_t policy = QUEUE_SINGLE_THREAD>
+class RingQueue;
+
+template <typename data_t, uint16_t size>
+class RingQueue<data_t, size, QUEUE_SINGLE_THREAD>
+{
+	public:
+		static const uint32_t	CAPACITY = next_pow2(size);
+		RingQueue() : head(0), tail(0) {}
+		bool			push(const data_t& item);
+		bool			pop(data_t& item);
+		uint32_t	get_count() const { return tail - head; }
+		bool			is_empty() const { return tail == head; }
+		bool			is_full() const { return tail - head == CAPACITY; }
+	private:
+		static const uint32_t	MASK = CAPACITY - 1;
+		alignas(CACHE_LINE_SIZE) uint32_t	head;
+		alignas(CACHE_LINE_SIZE) uint32_t	tail;
+		alignas(CACHE_LINE_SIZE) data_t		data[CAPACITY];
+};
+
+template <typename data_t, uint16_t size>
+bool	RingQueue<data_t, size, QUEUE_SINGLE_THREAD>::push(const data_t& item)
+{
+	bool	result = false;
+
+	if (!is_full())
+	{
+		data[tail & MASK] = item;
+		++tail;
+		result = true;
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size>
+bool	RingQueue<data_t, size, QUEUE_SINGLE_THREAD>::pop(data_t& item)
+{
+	bool	result = false;
+
+	if (!is_empty())
+	{
+		item = data[head & MASK];
+		++head;
+		result = true;
+	}
+	return result;
+}
+
+// Lamport ring: each side owns one index and keeps a cached copy of the
+// other one, so the shared line is only re-read when the cache says
+// full/empty.
+template <typename data_t, uint16_t size>
+class RingQueue<data_t, size, QUEUE_SPSC>
+{
+	public:
+		static const uint32_t	CAPACITY = next_pow2(size);
+		RingQueue() : head(0), tail_cache(0), tail(0), head_cache(0) {}
+		bool			push(const data_t& item);
+		bool			pop(data_t& item);
+		uint32_t	get_count() const;
+		bool			is_empty() const { return get_count() == 0; }
+		bool			is_full() const { return get_count() == CAPACITY; }
+	private:
+		static const uint32_t	MASK = CAPACITY - 1;
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t>	head;
+		uint32_t	tail_cache;
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t>	tail;
+		uint32_t	head_cache;
+		alignas(CACHE_LINE_SIZE) data_t	data[CAPACITY];
+};
+
+template <typename data_t, uint16_t size>
+bool	RingQueue<data_t, size, QUEUE_SPSC>::push(const data_t& item)
+{
+	uint32_t	pos = tail.load(std::memory_order_relaxed);
+	bool			result = true;
+
+	if (pos - head_cache == CAPACITY)
+	{
+		head_cache = head.load(std::memory_order_acquire);
+		result = pos - head_cache != CAPACITY;
+	}
+	if (result)
+	{
+		data[pos & MASK] = item;
+		tail.store(pos + 1, std::memory_order_release);
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size>
+bool	RingQueue<data_t, size, QUEUE_SPSC>::pop(data_t& item)
+{
+	uint32_t	pos = head.load(std::memory_order_relaxed);
+	bool			result = true;
+
+	if (pos == tail_cache)
+	{
+		tail_cache = tail.load(std::memory_order_acquire);
+		result = pos != tail_cache;
+	}
+	if (result)
+	{
+		item = data[pos & MASK];
+		head.store(pos + 1, std::memory_order_release);
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size>
+uint32_t	RingQueue<data_t, size, QUEUE_SPSC>::get_count() const
+{
+	return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+// Bounded MPSC ring with a sequence number per cell (Vyukov). Producers
+// claim a position with CAS on tail; a cell is readable once its sequence
+// is pos + 1 and writable again at pos + CAPACITY.
+template <typename data_t, uint16_t size>
+class RingQueue<data_t, size, QUEUE_MPSC>
+{
+	public:
+		static const uint32_t	CAPACITY = next_pow2(size);
+		RingQueue();
+		bool			push(const data_t& item);
+		bool			pop(data_t& item);
+		uint32_t	get_count() const;
+		bool			is_empty() const { return get_count() == 0; }
+		bool			is_full() const { return get_count() >= CAPACITY; }
+	private:
+		static const uint32_t	MASK = CAPACITY - 1;
+		struct	cell_t
+		{
+			std::atomic<uint32_t>	seq;
+			data_t								data;
+		};
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t>	head;
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t>	tail;
+		alignas(CACHE_LINE_SIZE) cell_t	cells[CAPACITY];
+};
+
+template <typename data_t, uint16_t size>
+RingQueue<data_t, size, QUEUE_MPSC>::RingQueue() : head(0), tail(0)
+{
+	for (uint32_t i = 0; i < CAPACITY; ++i)
+	{
+		cells[i].seq.store(i, std::memory_order_relaxed);
+	}
+}
+
+template <typename data_t, uint16_t size>
+bool	RingQueue<data_t, size, QUEUE_MPSC>::push(const data_t& item)
+{
+	uint32_t	pos = tail.load(std::memory_order_relaxed);
+	cell_t		*cell = nullptr;
+	int32_t		diff;
+	bool			claimed = false;
+	bool			full = false;
+
+	while (!claimed && !full)
+	{
+		cell = &cells[pos & MASK];
+		diff = static_cast<int32_t>(cell->seq.load(std::memory_order_acquire) - pos);
+		if (diff == 0)
+		{
+			claimed = tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed);
+		}
+		else if (diff < 0)
+		{
+			full = true;
+		}
+		else
+		{
+			pos = tail.load(std::memory_order_relaxed);
+		}
+	}
+	if (claimed)
+	{
+		cell->data = item;
+		cell->seq.store(pos + 1, std::memory_order_release);
+	}
+	return claimed;
+}
+
+template <typename data_t, uint16_t size>
+bool	RingQueue<data_t, size, QUEUE_MPSC>::pop(data_t& item)
+{
+	uint32_t	pos = head.load(std::memory_order_relaxed);
+	cell_t		*cell = &cells[pos & MASK];
+	bool			result = cell->seq.load(std::memory_order_acquire) == pos + 1;
+
+	if (result)
+	{
+		item = cell->data;
+		cell->seq.store(pos + CAPACITY, std::memory_order_release);
+		head.store(pos + 1, std::memory_order_relaxed);
+	}
+	return result;
+}
+
+template <typename data_t, uint16_t size>
+uint32_t	RingQueue<data_t, size, QUEUE_MPSC>::get_count() const
+{
+	return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+#endif // RING_QUEUE_HPP
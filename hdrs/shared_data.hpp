@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/08/04 09:50:37 by blackrider        #+#    #+#             */
-/*   Updated: 2025/08/04 09:54:30 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/26 19:04:50 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,9 +14,15 @@
 #define SHARED_DATA_HPP
 
 #include "shared_param.hpp"
-#include "queue.hpp"
+#include "retransmit_scheduler.hpp"
+#include "param_idx_map.hpp"
+#include "shared_data_traits.hpp"
+#include "timer_wheel.hpp"
+#include "message_view.hpp"
 #include "test.hpp"
 #include "time_stampt.hpp"
+#include "perf_scope.hpp"
+#include "shared_data_stats.hpp"
 
 #include <cstdint>
 #include <cstring>
@@ -26,35 +32,51 @@
 
 using namespace std;
 
-using idx_t = uint8_t;
+#define CAN_DATA_MAX_LEN	64 // CAN FD payload
 
 enum message_type_t
 {
 	SSV_MESSAGE = 1,
 	SSRV_MESSAGE,
 	SSE_MESSAGE,
+	SSV_PACKED_MESSAGE,	// data[0] = N, then N ssv_message_t
 };
 
 struct can_data_t
 {
 	uint8_t		message_type;
-	uint8_t		data[sizeof(ssv_message_t)];
+	uint8_t		data[CAN_DATA_MAX_LEN];
 	uint16_t	data_len;
 
 	uint16_t	idx;
 	uint16_t	idx_can;
 };
 
+// Per-call transmit budget for the batched get_messages. Frames are
+// shared between the classes that have work in proportion to their
+// weights; a zero weight keeps that class silent.
+struct	tx_budget_t
+{
+	uint16_t	max_bytes;		// payload bytes per call, 0 = frames only
+	uint8_t		sse_weight;
+	uint8_t		ssrv_weight;
+	uint8_t		ssv_weight;
+};
+
 template <uint16_t count>
 class SharedData
 {
 	public:
 		SharedData();
-		void	set_param_num(uint16_t param_num);
+		bool	set_param_num(uint16_t param_num);
 		void	period_counter();
 		bool	add_ssrv_message(uint16_t param_num, int32_t new_param_val);
 		bool	get_messages(can_data_t &can_data);
-		bool	handle_messages(can_data_t &can_data);
+		size_t	get_messages(can_data_t *out, size_t max_frames, const tx_budget_t& budget);
+		bool	handle_messages(const can_data_t &can_data);
+		void	set_payload_mtu(uint16_t mtu);
+		uint8_t	get_ssv_per_frame() const { return ssv_per_frame; }
+		void	get_stats(shared_data_stats_t& snapshot) const;
 
 		// TEST PURPOSES ONLY
 		void	set_iterator(uint16_t idx, int16_t i)
@@ -65,61 +87,122 @@ class SharedData
 		{
 			return shared_params[idx].get_param_iterator(idx);
 		}	
+		uint16_t	test_get_idx(uint16_t p_num) const { return get_idx(p_num); }
+		uint16_t	test_check_ssrv_end_counters() { return check_ssrv_end_counters(); }
 	private:
+		typedef typename SharedDataTraits<count>::idx_t				idx_t;
+		typedef typename SharedDataTraits<count>::tick_t			tick_t;
+		typedef typename SharedDataTraits<count>::tick_diff_t	tick_diff_t;
 		struct ssrv_service_t
 		{
-			idx_t	idx;
+			idx_t		idx;
+			tick_t	start;
 		};
 		struct	sse_service_t
 		{
 			uint8_t	counter;
-			uint8_t	idx;
+			idx_t		idx;
 		};
-		static const uint8_t	QUEUE_SIZE = count / 5 + 1;
+		static const uint16_t	QUEUE_SIZE = SharedDataTraits<count>::QUEUE_SIZE;
 		static const uint8_t	SSV_PERIOD = 5;	
 		static const uint8_t	SSRV_PERIOD = 2;
 		static const uint8_t	SSE_PERIOD = 5;
 		static const uint8_t	SSRV_ATTEMPTS = 3;
 		static const uint8_t	SSRV_WAIT_TICKS = 25;
-		uint8_t		tick;
+		static const uint16_t	SSRV_WHEEL_SLOTS = next_pow2(SSRV_WAIT_TICKS + 1);
+		static const uint8_t	SSV_PACKED_MAX = (CAN_DATA_MAX_LEN - 1) / sizeof(ssv_message_t);
+		enum	tx_class_t
+		{
+			TX_SSE,
+			TX_SSRV,
+			TX_SSV,
+			TX_CLASSES,
+		};
+		tick_t		tick;
 		uint16_t	idx_ssv;
+		uint8_t		ssv_per_frame;
+		int32_t		tx_credit[TX_CLASSES];
 		SharedParam	shared_params[count];
-		FSQueue<ssrv_service_t, QUEUE_SIZE>	ssrv_queue;
-		FSQueue<sse_service_t, QUEUE_SIZE>	sse_queue;
+		ParamIdxMap<idx_t, count>	param_idx_map;
+		RetransmitScheduler<ssrv_service_t, QUEUE_SIZE, tick_t>	ssrv_queue;
+		RetransmitScheduler<sse_service_t, QUEUE_SIZE, tick_t>	sse_queue;
+		TimerWheel<idx_t, count, tick_t, SSRV_WHEEL_SLOTS>	ssrv_timers;
+		StatsBlock	stats[STATS_ROLES];
 		bool			get_ssv_message(ssv_message_t &message);
 		bool			get_ssrv_message(ssrv_message_t &message);
 		bool			get_sse_message(sse_message_t& message);
 		bool			set_ssv_message(can_data_t &can_data);
 		bool			set_ssrv_message(can_data_t &can_data);
 		bool			set_sse_message(can_data_t &can_data);
+		bool			set_ssv_frame(can_data_t &can_data);
+		bool			set_ssv_packed_frame(can_data_t &can_data);
+		uint8_t		get_ssv_frame_len() const;
+		void			handle_ssv_packed_message(const can_data_t &can_data, uint16_t data_len);
+		bool			set_ssrv_frame(can_data_t &can_data);
+		bool			set_tx_frame(uint8_t tx_class, can_data_t &can_data);
+		uint8_t		pick_tx_class(const bool *active, const uint8_t *weights) const;
+		void			charge_tx_class(uint8_t tx_class, const bool *active, const uint8_t *weights);
 		bool			handle_ssv_message(const ssv_message_t &message, const uint16_t id, const uint16_t id_can);
 		bool			handle_ssrv_message(const ssrv_message_t &message);
 		bool			handle_sse_message(const sse_message_t& message);
 		idx_t			get_idx(uint16_t p_num) const;
 		uint16_t	check_ssrv_end_counters();
-		inline int8_t		get_ticks_diff(uint8_t ticks_stamp)
-		{
-			return static_cast<int16_t>(tick - ticks_stamp);
-		}
 };
 
 template <uint16_t count>
-SharedData<count>::SharedData() : tick(0), idx_ssv(0)
+SharedData<count>::SharedData() : tick(0), idx_ssv(0), ssv_per_frame(1), tx_credit{}
 {
 
 }
 
+// Numbers the next slot, round robin. The slot's previous number is
+// erased from the map, so renumbering can go on forever. Returns false if
+// the number could not be mapped; get_idx() then does not find it.
 template <uint16_t count>
-void	SharedData<count>::set_param_num(uint16_t param_num)
+bool	SharedData<count>::set_param_num(uint16_t param_num)
 {
+	uint16_t	old_num = shared_params[idx_ssv].get_param_num();
+	bool			result;
+
+	if (old_num != param_num && param_idx_map.find(old_num) == idx_ssv)
+	{
+		param_idx_map.erase(old_num);
+	}
 	shared_params[idx_ssv].init(param_num);
+	result = param_idx_map.insert(param_num, idx_ssv);
 	idx_ssv = (idx_ssv + 1) % count;
+	return result;
 }
 
 template <uint16_t count>
 void	SharedData<count>::period_counter()
 {
 	tick++;
+	ssrv_timers.advance(tick);
+}
+
+// Snapshot for a monitoring thread: each role's block is read as of one
+// instant, the blocks one after another
+template <uint16_t count>
+void	SharedData<count>::get_stats(shared_data_stats_t& snapshot) const
+{
+	snapshot = shared_data_stats_t {};
+	for (uint8_t i = 0; i < STATS_ROLES; ++i)
+	{
+		stats[i].read(snapshot);
+	}
+}
+
+// Largest payload the transport carries per frame. Classic CAN (8 bytes)
+// keeps one SSV per frame; UDP or CAN FD packs as many as fit. Receivers
+// decode both formats whatever their own MTU is.
+template <uint16_t count>
+void	SharedData<count>::set_payload_mtu(uint16_t mtu)
+{
+	uint16_t	fit = mtu > 1 ? (mtu - 1) / sizeof(ssv_message_t) : 0;
+
+	ssv_per_frame = fit > 1 ? (fit < SSV_PACKED_MAX ? fit : SSV_PACKED_MAX) : 1;
+	ssv_per_frame = ssv_per_frame < count ? ssv_per_frame : count;
 }
 
 template <uint16_t count>
@@ -128,14 +211,17 @@ bool	SharedData<count>::add_ssrv_message(uint16_t param_num, int32_t new_param_v
 	ssrv_service_t	new_message
 	{
 		.idx = get_idx(param_num),
+		.start = tick,
 	};
 	bool	result = false;
 
+	stats[STATS_API].begin();
 	if (new_message.idx < count)
 	{
 		if (shared_params[new_message.idx].add_new_param_value(new_param_val, SSRV_ATTEMPTS))
 		{
-			result = ssrv_queue.push(new_message);
+			result = ssrv_queue.push(new_message, tick);
+			stats[STATS_API].add(STAT_SSRV_DROPPED, !result);
 		}
 		// mtx_out.lock();
 		// cout << "------========++++ SSRV ADD NEW MESSAGE ++++========------" << endl;
@@ -146,14 +232,17 @@ bool	SharedData<count>::add_ssrv_message(uint16_t param_num, int32_t new_param_v
 		// cout << "------========++++ SSRV ADD NEW MESSAGE ++++========------" << endl;
 		// mtx_out.unlock();
 	}
+	stats[STATS_API].end();
 	return result;
 }
 
 template <uint16_t count>
 bool	SharedData<count>::get_messages(can_data_t &can_data)
 {
+	PERF_SCOPE("SharedData::get_messages");
 	bool	result = false;
 
+	stats[STATS_TX].begin();
 	result = set_sse_message(can_data);
 	if (!result)
 	{
@@ -163,42 +252,184 @@ bool	SharedData<count>::get_messages(can_data_t &can_data)
 	{
 		result = set_ssv_message(can_data);
 	}
+	stats[STATS_TX].add(STAT_TICKS);
+	stats[STATS_TX].add(STAT_EMPTY_TICKS, !result);
+	stats[STATS_TX].end();
+	return result;
+}
+
+// Fills up to max_frames frames within budget. Unlike the one-frame
+// get_messages there is no per-class tick gating: the budget is the rate
+// limit, and retransmit spacing still comes from the schedulers. A class
+// leaves the round when it runs out of work, its next frame would break
+// max_bytes, or SSV has swept every parameter once. Returns the frame count.
+template <uint16_t count>
+size_t	SharedData<count>::get_messages(can_data_t *out, size_t max_frames, const tx_budget_t& budget)
+{
+	PERF_SCOPE("SharedData::get_messages(batch)");
+	const uint8_t	weights[TX_CLASSES] = { budget.sse_weight, budget.ssrv_weight, budget.ssv_weight };
+	const uint8_t	sizes[TX_CLASSES] = { sizeof(sse_message_t), sizeof(ssrv_message_t), get_ssv_frame_len() };
+	bool			active[TX_CLASSES];
+	uint32_t	bytes = 0;
+	uint16_t	ssv_params = 0;
+	size_t		frames = 0;
+	uint8_t		tx_class;
+
+	stats[STATS_TX].begin();
+	for (uint8_t i = 0; i < TX_CLASSES; ++i)
+	{
+		active[i] = weights[i] > 0;
+	}
+	tx_class = pick_tx_class(active, weights);
+	while (frames < max_frames && tx_class < TX_CLASSES)
+	{
+		if (budget.max_bytes && bytes + sizes[tx_class] > budget.max_bytes)
+		{
+			active[tx_class] = false;
+		}
+		else if (set_tx_frame(tx_class, out[frames]))
+		{
+			charge_tx_class(tx_class, active, weights);
+			bytes += out[frames].data_len;
+			++frames;
+			ssv_params += tx_class == TX_SSV ? ssv_per_frame : 0;
+			if (ssv_params >= count)
+			{
+				active[tx_class] = false;
+			}
+		}
+		else
+		{
+			// An idle class does not bank credit for a later burst
+			tx_credit[tx_class] = 0;
+			active[tx_class] = false;
+		}
+		tx_class = pick_tx_class(active, weights);
+	}
+	stats[STATS_TX].add(STAT_TICKS);
+	stats[STATS_TX].add(STAT_EMPTY_TICKS, frames == 0);
+	stats[STATS_TX].end();
+	return frames;
+}
+
+// Smooth weighted round robin: the active class with the highest credit
+// after this round's weights are added; ties go to the higher priority.
+// Returns TX_CLASSES when no class is active.
+template <uint16_t count>
+uint8_t	SharedData<count>::pick_tx_class(const bool *active, const uint8_t *weights) const
+{
+	uint8_t	result = TX_CLASSES;
+
+	for (uint8_t i = 0; i < TX_CLASSES; ++i)
+	{
+		if (active[i] && (result == TX_CLASSES
+			|| tx_credit[i] + weights[i] > tx_credit[result] + weights[result]))
+		{
+			result = i;
+		}
+	}
+	return result;
+}
+
+template <uint16_t count>
+void	SharedData<count>::charge_tx_class(uint8_t tx_class, const bool *active, const uint8_t *weights)
+{
+	int32_t	total = 0;
+
+	for (uint8_t i = 0; i < TX_CLASSES; ++i)
+	{
+		if (active[i])
+		{
+			tx_credit[i] += weights[i];
+			total += weights[i];
+		}
+	}
+	tx_credit[tx_class] -= total;
+}
+
+template <uint16_t count>
+bool	SharedData<count>::set_tx_frame(uint8_t tx_class, can_data_t &can_data)
+{
+	bool	result = false;
+
+	if (tx_class == TX_SSE)
+	{
+		result = set_sse_message(can_data);
+	}
+	if (tx_class == TX_SSRV)
+	{
+		result = set_ssrv_frame(can_data);
+	}
+	if (tx_class == TX_SSV)
+	{
+		result = set_ssv_frame(can_data);
+	}
 	return result;
 }
 
 template <uint16_t count>
-bool	SharedData<count>::handle_messages(can_data_t &can_data)
+bool	SharedData<count>::handle_messages(const can_data_t &can_data)
 {
-	ssv_message_t		ssv_message;
-	ssrv_message_t	ssrv_message;
-	sse_message_t		sse_message;
+	PERF_SCOPE("SharedData::handle_messages");
+	uint16_t							data_len = can_data.data_len < CAN_DATA_MAX_LEN ? can_data.data_len : CAN_DATA_MAX_LEN;
+	const ssv_message_t		*ssv_message = view_message<ssv_message_t>(can_data.data, data_len);
+	const ssrv_message_t	*ssrv_message = view_message<ssrv_message_t>(can_data.data, data_len);
+	const sse_message_t		*sse_message = view_message<sse_message_t>(can_data.data, data_len);
 	bool	result = false;
 
-	if (can_data.message_type == SSV_MESSAGE)
+	stats[STATS_RX].begin();
+	// Frames too short for their message type are dropped
+	if (can_data.message_type == SSV_MESSAGE && ssv_message)
 	{
-		memcpy(&ssv_message, can_data.data, can_data.data_len);
-		handle_ssv_message(ssv_message, can_data.idx, can_data.idx_can);
+		handle_ssv_message(*ssv_message, can_data.idx, can_data.idx_can);
+		stats[STATS_RX].add(STAT_SSV_RECEIVED);
+		result = true;
 	}
-	if (can_data.message_type == SSRV_MESSAGE)
+	if (can_data.message_type == SSRV_MESSAGE && ssrv_message)
 	{
-		memcpy(&ssrv_message, can_data.data, can_data.data_len);
-		handle_ssrv_message(ssrv_message);
+		handle_ssrv_message(*ssrv_message);
+		stats[STATS_RX].add(STAT_SSRV_RECEIVED);
+		result = true;
 		// mtx_out.lock();
 		// cout << "------========++++ SSRV RECEIVE ++++========------" << endl;
 		// cout << "PID: " << get_pid() << endl
-		// 			<< " PARAM NUMBER: " << ssrv_message.param_num << endl
-		// 			<< " PARAM VALUE: " << ssrv_message.param_val << endl
+		// 			<< " PARAM NUMBER: " << ssrv_message->param_num << endl
+		// 			<< " PARAM VALUE: " << ssrv_message->param_val << endl
 		// 			<< endl;
 		// print_time_stamp();
 		// cout << "------========++++ SSRV RECEIVE ++++========------" << endl;
 		// mtx_out.unlock();
 	}
-	if (can_data.message_type == SSE_MESSAGE)
+	if (can_data.message_type == SSE_MESSAGE && sse_message)
+	{
+		handle_sse_message(*sse_message);
+		stats[STATS_RX].add(STAT_SSE_RECEIVED);
+		result = true;
+	}
+	if (can_data.message_type == SSV_PACKED_MESSAGE && data_len > 0)
+	{
+		handle_ssv_packed_message(can_data, data_len);
+		stats[STATS_RX].add(STAT_SSV_RECEIVED);
+		result = true;
+	}
+	stats[STATS_RX].add(STAT_RX_DROPPED, !result);
+	stats[STATS_RX].end();
+	return result;
+}
+
+// Applies every tuple of a packed SSV in one pass, in place. The count
+// byte is trusted only as far as data_len allows.
+template <uint16_t count>
+void	SharedData<count>::handle_ssv_packed_message(const can_data_t &can_data, uint16_t data_len)
+{
+	uint8_t							ssv_count = can_data.data[0];
+	const ssv_message_t	*ssv_message = view_message<ssv_message_t>(can_data.data, data_len, 1);
+
+	for (uint8_t i = 0; i < ssv_count && ssv_message; ++i)
 	{
-		memcpy(&sse_message, can_data.data, can_data.data_len);
-		handle_sse_message(sse_message);
+		handle_ssv_message(*ssv_message, can_data.idx, can_data.idx_can);
+		ssv_message = view_message<ssv_message_t>(can_data.data, data_len, 1 + (i + 1) * sizeof(ssv_message_t));
 	}
-	return true;
 }
 
 template <uint16_t count>
@@ -225,21 +456,24 @@ bool	SharedData<count>::get_ssrv_message(ssrv_message_t &message)
 {
 	uint8_t	queue_counter = 0;
 	ssrv_service_t	ssrv_service;
-	bool	result = ssrv_queue.pop(ssrv_service);
+	tick_t	due = tick;
+	bool	result = ssrv_queue.peek_due(due) && ssrv_queue.pop_due(tick, ssrv_service);
 
 	if (result)
 	{
+		stats[STATS_TX].record(HIST_SSRV_LAG, static_cast<tick_diff_t>(tick - due));
 		shared_params[ssrv_service.idx].get_ssrv_end_counter(queue_counter);
 		shared_params[ssrv_service.idx].get_ssrv_m(message);
 		if ((--queue_counter) > 0)
 		{
-			ssrv_queue.push(ssrv_service);
-			ssrv_queue.swap(SSRV_PERIOD);
+			stats[STATS_TX].add(STAT_SSRV_DROPPED, !ssrv_queue.push(ssrv_service, tick + SSRV_PERIOD));
 			shared_params[ssrv_service.idx].set_ssrv_end_counter(queue_counter);
 		}
 		else
 		{
+			stats[STATS_TX].record(HIST_SSRV_ROUND, static_cast<tick_diff_t>(tick - ssrv_service.start));
 			shared_params[ssrv_service.idx].set_ssrv_end_counter(SSRV_WAIT_TICKS);
+			ssrv_timers.schedule(ssrv_service.idx, tick + SSRV_WAIT_TICKS);
 		}
 	}
 	return result;
@@ -249,16 +483,17 @@ template <uint16_t count>
 bool	SharedData<count>::get_sse_message(sse_message_t &message)
 {
 	sse_service_t	sse_service;
-	bool	result = sse_queue.pop(sse_service);
+	tick_t	due = tick;
+	bool	result = sse_queue.peek_due(due) && sse_queue.pop_due(tick, sse_service);
 
 	if (result)
 	{
+		stats[STATS_TX].record(HIST_SSE_LAG, static_cast<tick_diff_t>(tick - due));
 		shared_params[sse_service.idx].get_sse_m(message);
 		sse_service.counter--;
 		if (sse_service.counter > 0)
 		{
-			sse_queue.push(sse_service);
-			sse_queue.swap(SSE_PERIOD);
+			stats[STATS_TX].add(STAT_SSE_DROPPED, !sse_queue.push(sse_service, tick + SSE_PERIOD));
 		}
 	}
 	return result;
@@ -267,36 +502,75 @@ bool	SharedData<count>::get_sse_message(sse_message_t &message)
 template <uint16_t count>
 bool	SharedData<count>::set_ssv_message(can_data_t &can_data)
 {
-	ssv_message_t	message;
+	return (tick % SSV_PERIOD == 0) && set_ssv_frame(can_data);
+}
+
+template <uint16_t count>
+uint8_t	SharedData<count>::get_ssv_frame_len() const
+{
+	return ssv_per_frame > 1 ? 1 + ssv_per_frame * sizeof(ssv_message_t) : sizeof(ssv_message_t);
+}
+
+template <uint16_t count>
+bool	SharedData<count>::set_ssv_packed_frame(can_data_t &can_data)
+{
+	uint8_t				ssv_count = 0;
+	ssv_message_t	*message = encode_message<ssv_message_t>(can_data.data, CAN_DATA_MAX_LEN, 1);
+
+	while (ssv_count < ssv_per_frame && message && get_ssv_message(*message))
+	{
+		++ssv_count;
+		message = encode_message<ssv_message_t>(can_data.data, CAN_DATA_MAX_LEN, 1 + ssv_count * sizeof(ssv_message_t));
+	}
+	can_data.data[0] = ssv_count;
+	can_data.data_len = 1 + ssv_count * sizeof(ssv_message_t);
+	can_data.message_type = SSV_PACKED_MESSAGE;
+	return ssv_count > 0;
+}
+
+template <uint16_t count>
+bool	SharedData<count>::set_ssv_frame(can_data_t &can_data)
+{
+	ssv_message_t	*message = encode_message<ssv_message_t>(can_data.data, CAN_DATA_MAX_LEN);
 	bool	result = false;
 
-	if ((tick % SSV_PERIOD == 0) && get_ssv_message(message))
+	if (ssv_per_frame > 1)
+	{
+		result = set_ssv_packed_frame(can_data);
+	}
+	else if (get_ssv_message(*message))
 	{
-		memcpy(&can_data.data, &message, sizeof(ssv_message_t));
 		can_data.data_len = sizeof(ssv_message_t);
 		can_data.message_type = SSV_MESSAGE;
 		result = true;
 	}
+	stats[STATS_TX].add(STAT_SSV_SENT, result);
 	return result;
 }
 
 template <uint16_t count>
 bool	SharedData<count>::set_ssrv_message(can_data_t &can_data)
 {
-	ssrv_message_t	message;
+	return (tick % SSRV_PERIOD == 0) && set_ssrv_frame(can_data);
+}
+
+template <uint16_t count>
+bool	SharedData<count>::set_ssrv_frame(can_data_t &can_data)
+{
+	ssrv_message_t	*message = encode_message<ssrv_message_t>(can_data.data, CAN_DATA_MAX_LEN);
 	bool	result = false;
 
-	if ((tick % SSRV_PERIOD == 0) && get_ssrv_message(message))
+	if (get_ssrv_message(*message))
 	{
-		memcpy(&can_data.data, &message, sizeof(ssrv_message_t));
 		can_data.data_len = sizeof(ssrv_message_t);
 		can_data.message_type = SSRV_MESSAGE;
+		stats[STATS_TX].add(STAT_SSRV_SENT);
 		result = true;
 		// mtx_out.lock();
 		// cout << "------========++++ SSRV SEND ++++========------" << endl;
 		// cout << "PID: " << get_pid() << endl
-		// 			<< " PARAM NUMBER: " << message.param_num << endl
-		// 			<< " PARAM VALUE: " << message.param_val << endl
+		// 			<< " PARAM NUMBER: " << message->param_num << endl
+		// 			<< " PARAM VALUE: " << message->param_val << endl
 		// 			<< endl;
 		// print_time_stamp();
 		// cout << "------========++++ SSRV SEND ++++========------" << endl;
@@ -308,20 +582,20 @@ bool	SharedData<count>::set_ssrv_message(can_data_t &can_data)
 template <uint16_t count>
 bool	SharedData<count>::set_sse_message(can_data_t &can_data)
 {
-	sse_message_t	message;
+	sse_message_t	*message = encode_message<sse_message_t>(can_data.data, CAN_DATA_MAX_LEN);
 	bool	result = false;
 
-	if (get_sse_message(message))
+	if (get_sse_message(*message))
 	{
-		memcpy(&can_data.data, &message, sizeof(sse_message_t));
 		can_data.data_len = sizeof(sse_message_t);
 		can_data.message_type = SSE_MESSAGE;
+		stats[STATS_TX].add(STAT_SSE_SENT);
 		result = true;
 		// mtx_out.lock();
 		// cout << "------========++++ SSE SEND ++++========------" << endl;
 		// cout << "PID: " << get_pid() << endl
-		// 			<< " PARAM NUMBER: " << message.param_num << endl
-		// 			<< " ERROR CODE: " << static_cast<int>(message.error_code) << endl
+		// 			<< " PARAM NUMBER: " << message->param_num << endl
+		// 			<< " ERROR CODE: " << static_cast<int>(message->error_code) << endl
 		// 			<< endl;
 		// cout << "------========++++ SSE SEND ++++========------" << endl;
 		// mtx_out.unlock();
@@ -340,15 +614,22 @@ bool	SharedData<count>::handle_ssv_message(const ssv_message_t &message,
 		.idx = get_idx(message.param_num),
 	};
 	bool	result = false; 
+	bool	is_conflict = false;
 	
 	if (sse_service.idx < count)
 	{
-		result = shared_params[sse_service.idx].handle_ssv_m(message, id, id_can);
+		result = shared_params[sse_service.idx].handle_ssv_m(message, id, id_can, is_conflict);
+		stats[STATS_RX].add(STAT_ITERATOR_CONFLICTS, is_conflict);
 		if (!result)
 		{
-			sse_queue.push(sse_service);
+			stats[STATS_RX].add(STAT_OUT_OF_RANGE_SSV);
+			stats[STATS_RX].add(STAT_SSE_DROPPED, !sse_queue.push(sse_service, tick));
 		}
 	}
+	else
+	{
+		stats[STATS_RX].add(STAT_UNKNOWN_PARAM);
+	}
 	return result;
 }
 
@@ -360,16 +641,21 @@ bool	SharedData<count>::handle_ssrv_message(const ssrv_message_t &message)
 		.counter = 1,
 		.idx = get_idx(message.param_num),
 	};
-	bool	result;
+	bool	result = false;
 	
 	if (sse_service.idx < count)
 	{
 		result = shared_params[sse_service.idx].handle_ssrv_m(message);
 		if (!result)
 		{
-			sse_queue.push(sse_service);
+			stats[STATS_RX].add(STAT_OUT_OF_RANGE_SSRV);
+			stats[STATS_RX].add(STAT_SSE_DROPPED, !sse_queue.push(sse_service, tick));
 		}
 	}
+	else
+	{
+		stats[STATS_RX].add(STAT_UNKNOWN_PARAM);
+	}
 	return result;
 }
 
@@ -383,55 +669,36 @@ bool	SharedData<count>::handle_sse_message(const sse_message_t &message)
 	{
 		result = shared_params[idx].handle_sse_m(message);
 	}
+	else
+	{
+		stats[STATS_RX].add(STAT_UNKNOWN_PARAM);
+	}
 	return result;
 }
 
 template <uint16_t count>
-idx_t	SharedData<count>::get_idx(uint16_t p_num) const
+typename SharedData<count>::idx_t	SharedData<count>::get_idx(uint16_t p_num) const
 {
-	idx_t	left = 0;
-	idx_t	right = count;
-	idx_t 	mid = 0;
-	
-	while (left < right)
-	{
-		mid = left + (right - left) / 2;
-		if (shared_params[mid].get_param_num() == p_num)
-		{
-			break ;
-		}
-		if (shared_params[mid].get_param_num() < p_num)
-		{
-			left = mid + 1;
-		}
-		else
-		{
-			right = mid;
-		}
-	}
-	if (shared_params[mid].get_param_num() != p_num)
+	idx_t	idx = param_idx_map.find(p_num);
+
+	// The map and the slot must agree, e.g. after a number was given to two slots
+	if (idx < count && shared_params[idx].get_param_num() != p_num)
 	{
-		mid = count;
+		idx = count;
 	}
-	return mid;
+	return idx;
 }
 
 template <uint16_t count>
 uint16_t	SharedData<count>::check_ssrv_end_counters()
 {
 	uint8_t		ssrv_counter = 0;
-	uint16_t	idx = 0;
-	
-	while (idx < count)
+	uint16_t	idx = ssrv_timers.pop_expired();
+
+	// Skip timers whose SSRV was already settled by another path
+	while (idx < count && !shared_params[idx].get_ssrv_end_counter(ssrv_counter))
 	{
-		if (shared_params[idx].get_ssrv_end_counter(ssrv_counter))
-		{
-			if (get_ticks_diff(ssrv_counter) >= SSRV_WAIT_TICKS)
-			{
-				break ;
-			}
-		}
-		++idx;
+		idx = ssrv_timers.pop_expired();
 	}
 	return idx;
 }
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shared_data_actor.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/11 09:20:15 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 10:02:44 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHARED_DATA_ACTOR_HPP
+#define SHARED_DATA_ACTOR_HPP
+
+#include "shared_data.hpp"
+#include "ring_queue.hpp"
+
+#include <cstdint>
+#include <atomic>
+
+// Single-owner front end for SharedData. Receive and API threads only
+// post frames and SSRV requests into lock-free rings; the protocol thread
+// is the only one touching SharedData and drains both rings once per tick.
+template <uint16_t count>
+class SharedDataActor
+{
+	public:
+		SharedDataActor(SharedData<count> *shared_data);
+		// any thread
+		bool			post_frame(const can_data_t& can_data);
+		uint16_t	post_frames(const can_data_t *frames, uint16_t frames_count);
+		bool			post_ssrv(uint16_t param_num, int32_t new_param_val);
+		uint32_t	get_dropped() const;
+		// protocol thread only
+		uint32_t	drain_inbound();
+		bool			tick(can_data_t& can_data);
+		size_t		tick(can_data_t *out, size_t max_frames, const tx_budget_t& budget);
+	private:
+		struct	ssrv_request_t
+		{
+			uint16_t	param_num;
+			int32_t		param_val;
+		};
+		static const uint16_t	FRAME_RING_SIZE = 1024;
+		static const uint16_t	SSRV_RING_SIZE = 64;
+		SharedData<count>	*shared_data;
+		RingQueue<can_data_t, FRAME_RING_SIZE, QUEUE_MPSC>		frame_ring;
+		RingQueue<ssrv_request_t, SSRV_RING_SIZE, QUEUE_MPSC>	ssrv_ring;
+		std::atomic<uint32_t>	dropped;
+};
+
+template <uint16_t count>
+SharedDataActor<count>::SharedDataActor(SharedData<count> *shared_data) : shared_data(shared_data), dropped(0)
+{
+
+}
+
+template <uint16_t count>
+bool	SharedDataActor<count>::post_frame(const can_data_t& can_data)
+{
+	bool	result = frame_ring.push(can_data);
+
+	if (!result)
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	return result;
+}
+
+template <uint16_t count>
+uint16_t	SharedDataActor<count>::post_frames(const can_data_t *frames, uint16_t frames_count)
+{
+	uint16_t	posted = 0;
+
+	while (posted < frames_count && frame_ring.push(frames[posted]))
+	{
+		++posted;
+	}
+	if (posted < frames_count)
+	{
+		dropped.fetch_add(frames_count - posted, std::memory_order_relaxed);
+	}
+	return posted;
+}
+
+template <uint16_t count>
+bool	SharedDataActor<count>::post_ssrv(uint16_t param_num, int32_t new_param_val)
+{
+	ssrv_request_t	request
+	{
+		.param_num = param_num,
+		.param_val = new_param_val,
+	};
+	bool	result = ssrv_ring.push(request);
+
+	if (!result)
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	return result;
+}
+
+template <uint16_t count>
+uint32_t	SharedDataActor<count>::get_dropped() const
+{
+	return dropped.load(std::memory_order_relaxed);
+}
+
+template <uint16_t count>
+uint32_t	SharedDataActor<count>::drain_inbound()
+{
+	ssrv_request_t	request;
+	can_data_t			can_data;
+	uint32_t				handled = 0;
+
+	// Both drains are bounded by their ring size so a flood cannot stall the tick
+	for (uint32_t i = 0; i < ssrv_ring.CAPACITY && ssrv_ring.pop(request); ++i)
+	{
+		shared_data->add_ssrv_message(request.param_num, request.param_val);
+		++handled;
+	}
+	for (uint32_t i = 0; i < frame_ring.CAPACITY && frame_ring.pop(can_data); ++i)
+	{
+		shared_data->handle_messages(can_data);
+		++handled;
+	}
+	return handled;
+}
+
+template <uint16_t count>
+bool	SharedDataActor<count>::tick(can_data_t& can_data)
+{
+	drain_inbound();
+	shared_data->period_counter();
+	return shared_data->get_messages(can_data);
+}
+
+template <uint16_t count>
+size_t	SharedDataActor<count>::tick(can_data_t *out, size_t max_frames, const tx_budget_t& budget)
+{
+	drain_inbound();
+	shared_data->period_counter();
+	return shared_data->get_messages(out, max_frames, budget);
+}
+
+#endif // SHARED_DATA_ACTOR_HPP
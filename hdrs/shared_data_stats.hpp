@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shared_data_stats.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/26 10:12:47 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/26 16:40:19 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHARED_DATA_STATS_HPP
+#define SHARED_DATA_STATS_HPP
+
+#define STATS_HIST_BUCKETS	16
+
+#include "ring_queue.hpp"
+
+#include <cstdint>
+#include <atomic>
+
+enum	shared_stat_t
+{
+	STAT_SSV_SENT,						// frames, a packed SSV counts once
+	STAT_SSRV_SENT,
+	STAT_SSE_SENT,
+	STAT_SSV_RECEIVED,
+	STAT_SSRV_RECEIVED,
+	STAT_SSE_RECEIVED,
+	STAT_RX_DROPPED,					// frames too short or of unknown type
+	STAT_UNKNOWN_PARAM,				// messages for a parameter not held here
+	STAT_SSRV_DROPPED,				// ssrv_queue full
+	STAT_SSE_DROPPED,					// sse_queue full
+	STAT_OUT_OF_RANGE_SSV,
+	STAT_OUT_OF_RANGE_SSRV,
+	STAT_ITERATOR_CONFLICTS,	// another value with a stale iterator
+	STAT_TICKS,								// get_messages calls
+	STAT_EMPTY_TICKS,					// of which sent nothing
+	STAT_COUNT,
+};
+
+// Latencies in ticks, bucket 0 holds 0 and bucket b > 0 holds
+// [2^(b-1), 2^b); the last bucket takes everything above
+enum	shared_hist_t
+{
+	HIST_SSRV_LAG,		// SSRV attempt sent this late after its due tick
+	HIST_SSE_LAG,
+	HIST_SSRV_ROUND,	// add_ssrv_message to the last SSRV attempt
+	HIST_COUNT,
+};
+
+// One block per role, each written by a single thread only, see StatsBlock
+enum	stats_role_t
+{
+	STATS_TX,		// get_messages
+	STATS_RX,		// handle_messages
+	STATS_API,	// add_ssrv_message
+	STATS_ROLES,
+};
+
+struct	shared_data_stats_t
+{
+	uint64_t	counters[STAT_COUNT];
+	uint64_t	histograms[HIST_COUNT][STATS_HIST_BUCKETS];
+};
+
+// Counters of one writer on their own cache lines. Updates are plain
+// relaxed load/store pairs, not fetch_add, so a second writer on the same
+// block would lose counts and break the seqlock: only the thread that owns
+// SharedData (the SharedDataActor protocol thread, or the EventLoop thread
+// in run_nodes) may call begin/end/add/record. The seqlock lets a
+// monitoring thread read the block as of one instant: everything a
+// begin()/end() pair added, or none of it.
+class alignas(CACHE_LINE_SIZE) StatsBlock
+{
+	public:
+		StatsBlock() : seq(0), counters{}, histograms{} {}
+		void	begin()
+		{
+			seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+		void	end()
+		{
+			seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+		void	add(uint8_t stat, uint64_t n = 1)
+		{
+			bump(counters[stat], n);
+		}
+		void	record(uint8_t hist, uint64_t value)
+		{
+			bump(histograms[hist][get_bucket(value)], 1);
+		}
+		// Adds this block to out, any thread
+		void	read(shared_data_stats_t& out) const
+		{
+			shared_data_stats_t	copy;
+			uint32_t						before;
+			uint32_t						after;
+
+			do
+			{
+				before = seq.load(std::memory_order_acquire);
+				for (uint8_t i = 0; i < STAT_COUNT; ++i)
+				{
+					copy.counters[i] = counters[i].load(std::memory_order_relaxed);
+				}
+				for (uint8_t h = 0; h < HIST_COUNT; ++h)
+				{
+					for (uint8_t b = 0; b < STATS_HIST_BUCKETS; ++b)
+					{
+						copy.histograms[h][b] = histograms[h][b].load(std::memory_order_relaxed);
+					}
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);
+				after = seq.load(std::memory_order_relaxed);
+			} while ((before & 1) || before != after);
+			for (uint8_t i = 0; i < STAT_COUNT; ++i)
+			{
+				out.counters[i] += copy.counters[i];
+			}
+			for (uint8_t h = 0; h < HIST_COUNT; ++h)
+			{
+				for (uint8_t b = 0; b < STATS_HIST_BUCKETS; ++b)
+				{
+					out.histograms[h][b] += copy.histograms[h][b];
+				}
+			}
+		}
+		static uint8_t	get_bucket(uint64_t value)
+		{
+			uint8_t	result = value ? 64 - __builtin_clzll(value) : 0;
+
+			return result < STATS_HIST_BUCKETS ? result : STATS_HIST_BUCKETS - 1;
+		}
+	private:
+		std::atomic<uint32_t>	seq;
+		std::atomic<uint64_t>	counters[STAT_COUNT];
+		std::atomic<uint64_t>	histograms[HIST_COUNT][STATS_HIST_BUCKETS];
+		// Not atomic as a whole: single writer only
+		static void	bump(std::atomic<uint64_t>& counter, uint64_t n)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+};
+
+#endif // SHARED_DATA_STATS_HPP
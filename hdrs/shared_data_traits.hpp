@@ -0,0 +1,35 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shared_data_traits.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/06 09:48:19 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/06 10:15:52 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHARED_DATA_TRAITS_HPP
+#define SHARED_DATA_TRAITS_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+// Integer widths used by SharedData<count>. Indexes must also hold count
+// itself (the "not found" value), so byte indexes stop at 254 params.
+// Queued SSRV/SSE items can fall behind by roughly
+// QUEUE_SIZE * SSRV_ATTEMPTS * SSRV_PERIOD ticks (~1.2 * count), which
+// must stay inside the signed tick difference.
+template <uint16_t count>
+struct	SharedDataTraits
+{
+	static const bool	IS_SMALL = count < UINT8_MAX;
+	static const bool	IS_HUGE = count > 20000;
+	typedef typename std::conditional<IS_SMALL, uint8_t, uint16_t>::type	idx_t;
+	typedef typename std::conditional<IS_HUGE, uint32_t, uint16_t>::type	tick_t;
+	typedef typename std::make_signed<tick_t>::type	tick_diff_t;
+	static const uint16_t	QUEUE_SIZE = count / 5 + 1;
+};
+
+#endif // SHARED_DATA_TRAITS_HPP
@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/09 21:39:08 by Pablo Escob       #+#    #+#             */
-/*   Updated: 2025/07/21 14:24:53 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/26 10:12:47 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,20 +19,22 @@
 
 #include <mutex>
 
-struct	ssv_message_t
+// Wire structs: packed and may_alias so they can be read and written in
+// place inside a frame payload, see message_view.hpp
+struct __attribute__((packed, may_alias))	ssv_message_t
 {
 	int16_t		iterator;
 	uint16_t	param_num;
 	int32_t		param_val;
 };
 
-struct __attribute__((packed))	ssrv_message_t
+struct __attribute__((packed, may_alias))	ssrv_message_t
 {
 	int16_t		param_num;
 	int32_t		param_val;
 };
 
-struct __attribute__((packed))	sse_message_t
+struct __attribute__((packed, may_alias))	sse_message_t
 {
 	int8_t		error_code;
 	uint16_t	param_num;
@@ -60,7 +62,7 @@ class SharedParam
 		bool			get_ssv_m(ssv_message_t& message);
 		bool			get_ssrv_m(ssrv_message_t& message);
 		bool			get_sse_m(sse_message_t& message);
-		bool			handle_ssv_m(const ssv_message_t& message, uint16_t idx, uint16_t idx_can);
+		bool			handle_ssv_m(const ssv_message_t& message, uint16_t idx, uint16_t idx_can, bool& is_conflict);
 		bool			handle_ssrv_m(const ssrv_message_t& message);
 		bool			handle_sse_m(const sse_message_t& message);
 		uint16_t	get_param_num() const;
@@ -82,7 +84,7 @@ class SharedParam
 		uint16_t		param_num;
 		int32_t			new_param_value;
 		P_Iterator	iterator;
-		bool		is_req_update_param_value(const ssv_message_t& message, uint16_t idx, uint16_t idx_can);
+		bool		is_req_update_param_value(const ssv_message_t& message, uint16_t idx, uint16_t idx_can, bool& is_conflict);
 		int32_t	get_param_value();
 		int32_t	get_param_max_value();
 		void		set_param_value(int32_t p_value);
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shm_transport.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/22 10:21:40 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 09:20:15 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHM_TRANSPORT_HPP
+#define SHM_TRANSPORT_HPP
+
+#define SHM_BUS_NAME		"/shared_data_bus"
+#define SHM_RING_SLOTS	1024
+
+#include "shared_data.hpp"
+#include "ring_queue.hpp"
+
+#include <cstdint>
+#include <atomic>
+
+// Broadcast ring in POSIX shared memory for nodes on one host. Every
+// writer claims a position with one fetch_add; every reader keeps its own
+// cursor and sees every frame, its own included, like multicast loopback.
+// A reader more than SHM_RING_SLOTS behind loses the oldest frames, as on
+// a bus. Send and receive are plain memory operations; the only syscall
+// is the futex wake, and only while a reader is blocked in wait_shm.
+struct	shm_slot_t
+{
+	std::atomic<uint64_t>	seq;		// 2 * pos + 1 while writing, 2 * pos + 2 when ready
+	can_data_t						frame;
+};
+
+struct	shm_ring_t
+{
+	alignas(CACHE_LINE_SIZE) std::atomic<uint64_t>	head;
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t>	wake_seq;
+	std::atomic<uint32_t>														waiters;
+	alignas(CACHE_LINE_SIZE) shm_slot_t							slots[SHM_RING_SLOTS];
+};
+
+static_assert((SHM_RING_SLOTS & (SHM_RING_SLOTS - 1)) == 0, "SHM_RING_SLOTS must be a power of two");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shm ring needs lock-free 64-bit atomics");
+
+struct	shm_data_t
+{
+	shm_ring_t	*ring;
+	uint64_t		cursor;		// next position this reader expects
+	uint64_t		lost;			// frames overwritten before this reader got them
+};
+
+shm_data_t	create_shm_transport(const char *name = SHM_BUS_NAME);
+const char	*open_shm_transport(shm_data_t& shm_data, const char *name = SHM_BUS_NAME);
+void				close_shm_transport(shm_data_t& shm_data);
+void				unlink_shm_transport(const char *name = SHM_BUS_NAME);
+void				send_shm(const shm_data_t& shm_data, const can_data_t& frame);
+bool				receive_shm(shm_data_t& shm_data, can_data_t& frame);
+uint16_t		receive_shm_batch(shm_data_t& shm_data, can_data_t *frames, uint16_t max_frames);
+bool				wait_shm(shm_data_t& shm_data, int timeout_ms);
+
+#endif // SHM_TRANSPORT_HPP
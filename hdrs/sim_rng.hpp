@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sim_rng.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 14:20:11 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/23 14:20:11 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SIM_RNG_HPP
+#define SIM_RNG_HPP
+
+#include <cstdint>
+
+// splitmix64: one add and three xor-shift-multiplies per draw. Unlike the
+// <random> distributions its output is fixed by the algorithm, so a seed
+// replays the same run on every compiler and libc.
+class SimRng
+{
+	public:
+		SimRng(uint64_t seed = 0) : state(seed) {}
+		uint64_t	next()
+		{
+			uint64_t	z = (state += 0x9E3779B97F4A7C15ull);
+
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+		// Uniform in [0, bound), bound > 0; the modulo bias is below 2^-32
+		// for the bounds a simulation uses
+		uint64_t	below(uint64_t bound) { return next() % bound; }
+		// Uniform in [0, 1) with 53 random bits
+		double		unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+		bool			chance(double p) { return p > 0.0 && unit() < p; }
+	private:
+		uint64_t	state;
+};
+
+#endif // SIM_RNG_HPP
@@ -6,7 +6,7 @@
 /*   By: Pablo Escobar <sataniv.rider@gmail.com>    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/27 23:39:08 by Pablo Escob       #+#    #+#             */
-/*   Updated: 2025/07/29 22:23:03 by Pablo Escob      ###   ########.fr       */
+/*   Updated: 2025/08/26 17:58:03 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,43 +20,151 @@
 #define MULTICAST_IP    			"239.0.0.1"
 #define MULTICAST_SSRV_IP    	"239.1.1.1"
 #define MULTICAST_TEST_IP    	"239.1.1.0"
+#define MULTICAST_RELAY_IP   	"239.1.2.0"
+#define MULTICAST_RELAY_PORT 	13000   // fault_relay output, + PID of the receiving node
 
 #include "test.hpp"
 
 #include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <sys/uio.h>
 
 void die(const char* message);
-udp_data_t	create_sender_socket(const char* multicast_ip = MULTICAST_IP, uint16_t multicast_port = MULTICAST_PORT);
-udp_data_t	create_receive_socket(const char* multicast_ip = MULTICAST_IP, uint16_t multicast_port = MULTICAST_PORT);
+udp_data_t	create_sender_socket(const char* multicast_ip = MULTICAST_IP, uint16_t multicast_port = MULTICAST_PORT,
+													bool non_blocking = false);
+udp_data_t	create_receive_socket(const char* multicast_ip = MULTICAST_IP, uint16_t multicast_port = MULTICAST_PORT,
+													bool non_blocking = false);
+// Same without dying: NULL on success, else what failed (errno is set)
+const char	*open_sender_socket(udp_data_t& udp_data, const char* multicast_ip, uint16_t multicast_port,
+															bool non_blocking);
+const char	*open_receive_socket(udp_data_t& udp_data, const char* multicast_ip, uint16_t multicast_port,
+															bool non_blocking);
 template <typename send_t>
 void	send_udp(const udp_data_t& udp_data, send_t& data);
 template <typename send_t>
 void	send_udp(const udp_data_t& udp_data, send_t *data, size_t data_size);
 template <typename receive_t>
-void 	receive_udp(const udp_data_t& udp_data, receive_t& data);
+bool 	receive_udp(const udp_data_t& udp_data, receive_t& data);
+
+// Preallocated recvmmsg/sendmmsg state for up to batch_size datagrams of
+// data_t; every message points at its own data[] slot.
+template <typename data_t, uint16_t batch_size>
+struct	udp_batch_t
+{
+	mmsghdr			msgs[batch_size];
+	iovec				iovecs[batch_size];
+	sockaddr_in	addrs[batch_size];
+	data_t			data[batch_size];
+
+	udp_batch_t()
+	{
+		memset(msgs, 0, sizeof(msgs));
+		for (uint16_t i = 0; i < batch_size; ++i)
+		{
+			iovecs[i].iov_base = &data[i];
+			iovecs[i].iov_len = sizeof(data_t);
+			msgs[i].msg_hdr.msg_iov = &iovecs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+	}
+	// Variable-length payloads: bytes received, or bytes to send from data[i]
+	inline uint16_t	get_length(uint16_t i) const { return static_cast<uint16_t>(msgs[i].msg_len); }
+	inline void			set_length(uint16_t i, uint16_t len) { iovecs[i].iov_len = len; }
+};
+
+template <typename receive_t, uint16_t batch_size>
+uint16_t	receive_udp_batch(const udp_data_t& udp_data, udp_batch_t<receive_t, batch_size>& batch);
+template <typename send_t, uint16_t batch_size>
+uint16_t	send_udp_batch(const udp_data_t& udp_data, udp_batch_t<send_t, batch_size>& batch, uint16_t count);
 
 
+// A non-blocking socket with nothing to read, or a full send buffer
+static inline bool	would_block()
+{
+	return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+// On a non-blocking socket a full send buffer drops the datagram, like
+// the bus would; the protocol retransmits anyway
 template <typename send_t>
 void	send_udp(const udp_data_t& udp_data, send_t& data)
 {
-	if (sendto(udp_data.sock_fd, &data, sizeof(data), 0, (struct sockaddr*)&(udp_data.remote_addr), sizeof(udp_data.remote_addr)) < 0)
+	if (sendto(udp_data.sock_fd, &data, sizeof(data), 0, (struct sockaddr*)&(udp_data.remote_addr), sizeof(udp_data.remote_addr)) < 0
+		&& !would_block())
 		die("sendto failed");
 }
 
 template <typename send_t>
 void	send_udp(const udp_data_t& udp_data, send_t *data, size_t data_size)
 {
-	if (sendto(udp_data.sock_fd, data, data_size, 0, (struct sockaddr*)&(udp_data.remote_addr), sizeof(udp_data.remote_addr)) < 0)
+	if (sendto(udp_data.sock_fd, data, data_size, 0, (struct sockaddr*)&(udp_data.remote_addr), sizeof(udp_data.remote_addr)) < 0
+		&& !would_block())
 		die("sendto failed");
 }
 
+// Returns false only when a non-blocking socket has nothing queued
 template <typename receive_t>
-void 	receive_udp(const udp_data_t& udp_data, receive_t& data)
+bool 	receive_udp(const udp_data_t& udp_data, receive_t& data)
 {
-	static socklen_t addr_len = sizeof(udp_data.remote_addr);
+	sockaddr_in	remote_addr {};
+	socklen_t		addr_len = sizeof(remote_addr);
+	bool				result = true;
 	
-	if (recvfrom(udp_data.sock_fd, &data, sizeof(data), 0, (struct sockaddr*)&(udp_data.remote_addr), &addr_len) < 0)
-		die("recvfrom failed");
+	if (recvfrom(udp_data.sock_fd, &data, sizeof(data), 0, (struct sockaddr*)&remote_addr, &addr_len) < 0)
+	{
+		if (!would_block())
+			die("recvfrom failed");
+		result = false;
+	}
+	return result;
+}
+
+// Blocks until at least one datagram is queued, then takes everything
+// already waiting, up to batch_size, in one syscall. A non-blocking
+// socket returns 0 instead of blocking.
+template <typename receive_t, uint16_t batch_size>
+uint16_t	receive_udp_batch(const udp_data_t& udp_data, udp_batch_t<receive_t, batch_size>& batch)
+{
+	int	received;
+
+	for (uint16_t i = 0; i < batch_size; ++i)
+	{
+		batch.msgs[i].msg_hdr.msg_name = &batch.addrs[i];
+		batch.msgs[i].msg_hdr.msg_namelen = sizeof(batch.addrs[i]);
+		batch.set_length(i, sizeof(receive_t));
+	}
+	received = recvmmsg(udp_data.sock_fd, batch.msgs, batch_size, MSG_WAITFORONE, NULL);
+	if (received < 0 && !would_block())
+		die("recvmmsg failed");
+	if (received < 0)
+		received = 0;
+	return static_cast<uint16_t>(received);
+}
+
+// Sends data[0..count) with the lengths given by set_length(), resuming
+// where sendmmsg stops early. Returns how many went out; when that is
+// short of count, errno tells a full non-blocking socket (would_block())
+// from a real error. The caller decides whether to drop or count them.
+template <typename send_t, uint16_t batch_size>
+uint16_t	send_udp_batch(const udp_data_t& udp_data, udp_batch_t<send_t, batch_size>& batch, uint16_t count)
+{
+	uint16_t	sent = 0;
+	int				result = 0;
+
+	count = count < batch_size ? count : batch_size;
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		batch.msgs[i].msg_hdr.msg_name = (void *)&udp_data.remote_addr;
+		batch.msgs[i].msg_hdr.msg_namelen = sizeof(udp_data.remote_addr);
+	}
+	while (sent < count && result >= 0)
+	{
+		result = sendmmsg(udp_data.sock_fd, batch.msgs + sent, count - sent, 0);
+		if (result >= 0)
+			sent += result;
+	}
+	return sent;
 }
 
 #endif
\ No newline at end of file
@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/08/04 09:50:57 by blackrider        #+#    #+#             */
-/*   Updated: 2025/08/04 09:55:12 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/24 12:31:09 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,7 +17,17 @@
 #include <netinet/in.h>    // sockaddr_in structure
 #include <arpa/inet.h>     // inet_addr(), inet_ntoa(), etc.
 
-#define P_COUNT 110
+#ifndef P_COUNT
+# define P_COUNT 110
+#endif
+
+enum	transport_kind_t
+{
+	TRANSPORT_UDP,				// multicast group, one host or a LAN
+	TRANSPORT_SHM,				// shared-memory ring, processes on one host
+	TRANSPORT_LOOPBACK,		// in-process bus, no syscalls at all
+	TRANSPORT_UDP_RELAY,	// multicast through fault_relay
+};
 
 struct	udp_data_t
 {
@@ -50,6 +60,8 @@ struct heartbeat_t
 
 uint16_t	get_pid();
 void	run_app(uint16_t pid, uint16_t iterator_start_value, uint16_t param_kef);
+void	run_nodes(uint16_t first_pid, uint16_t nodes_count, uint16_t iterator_start_value, uint16_t param_kef,
+									transport_kind_t transport_kind = TRANSPORT_UDP);
 // void	start_test(uint16_t pid, uint16_t iterator_start_value, uint16_t param_kef);
 
 #endif // TEST_HPP
\ No newline at end of file
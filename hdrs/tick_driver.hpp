@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tick_driver.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/17 10:02:44 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/17 15:27:09 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TICK_DRIVER_HPP
+#define TICK_DRIVER_HPP
+
+#include <cstdint>
+#include <time.h>
+
+// Fixed-rate tick source on absolute CLOCK_MONOTONIC deadlines. Work done
+// inside a tick does not push the next deadline back, so SSV/SSRV/SSE
+// periods counted in ticks hold under load. Owned by one thread.
+class TickDriver
+{
+	public:
+		struct	stats_t
+		{
+			uint64_t	ticks;					// ticks handed out by wait_next
+			uint64_t	late_wakeups;		// wakeups at least one period late
+			uint64_t	missed;					// deadlines skipped, never run
+			int64_t		jitter_min_ns;	// wakeup time - deadline
+			int64_t		jitter_max_ns;
+			int64_t		jitter_sum_ns;
+			uint64_t	jitter_count;
+		};
+		TickDriver(uint32_t period_us, bool catch_up = true, uint16_t max_catch_up = 8);
+		void			start();
+		uint16_t	wait_next();
+		void			reset_stats();
+		const stats_t&	get_stats() const { return stats; }
+		int64_t		get_jitter_mean_ns() const;
+	private:
+		int64_t		period_ns;
+		bool			catch_up;
+		uint16_t	max_catch_up;
+		int64_t		deadline_ns;
+		stats_t		stats;
+		static int64_t	now_ns();
+};
+
+#endif // TICK_DRIVER_HPP
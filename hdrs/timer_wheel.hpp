@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timer_wheel.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/07 08:55:04 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/07 12:37:29 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstdint>
+
+// Hashed timing wheel for per-slot deadlines. Every slot (0 .. count - 1)
+// holds at most one timer, chained through intrusive prev/next arrays, so
+// schedule/cancel are O(1) and advance() only touches one bucket.
+// Timers that reach their tick move to a FIFO expired list.
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+class TimerWheel
+{
+	public:
+		TimerWheel();
+		void	schedule(idx_t idx, tick_t tick);
+		void	cancel(idx_t idx);
+		void	advance(tick_t now);
+		idx_t	pop_expired();
+		bool	is_scheduled(idx_t idx) const;
+	private:
+		static_assert((slots & (slots - 1)) == 0, "TimerWheel slots must be a power of two");
+		static const uint16_t	MASK = slots - 1;
+		enum e_timer_state
+		{
+			TIMER_IDLE,
+			TIMER_PENDING,
+			TIMER_EXPIRED,
+		};
+		struct	list_t
+		{
+			idx_t	head;
+			idx_t	tail;
+		};
+		idx_t		next[count];
+		idx_t		prev[count];
+		tick_t	deadline[count];
+		uint8_t	state[count];
+		list_t	buckets[slots];
+		list_t	expired;
+		void		link(list_t& list, idx_t idx);
+		void		unlink(list_t& list, idx_t idx);
+		inline list_t&	get_list(idx_t idx)
+		{
+			return state[idx] == TIMER_EXPIRED ? expired : buckets[deadline[idx] & MASK];
+		}
+};
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+TimerWheel<idx_t, count, tick_t, slots>::TimerWheel()
+{
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		next[i] = count;
+		prev[i] = count;
+		deadline[i] = 0;
+		state[i] = TIMER_IDLE;
+	}
+	for (uint16_t i = 0; i < slots; ++i)
+	{
+		buckets[i] = { count, count };
+	}
+	expired = { count, count };
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+void	TimerWheel<idx_t, count, tick_t, slots>::schedule(idx_t idx, tick_t tick)
+{
+	if (idx < count)
+	{
+		cancel(idx);
+		deadline[idx] = tick;
+		state[idx] = TIMER_PENDING;
+		link(buckets[tick & MASK], idx);
+	}
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+void	TimerWheel<idx_t, count, tick_t, slots>::cancel(idx_t idx)
+{
+	if (idx < count && state[idx] != TIMER_IDLE)
+	{
+		unlink(get_list(idx), idx);
+		state[idx] = TIMER_IDLE;
+	}
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+void	TimerWheel<idx_t, count, tick_t, slots>::advance(tick_t now)
+{
+	list_t&	bucket = buckets[now & MASK];
+	idx_t		idx = bucket.head;
+	idx_t		next_idx;
+
+	while (idx != count)
+	{
+		next_idx = next[idx];
+		// Entries more than one lap ahead share the bucket; leave them
+		if (deadline[idx] == now)
+		{
+			unlink(bucket, idx);
+			state[idx] = TIMER_EXPIRED;
+			link(expired, idx);
+		}
+		idx = next_idx;
+	}
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+idx_t	TimerWheel<idx_t, count, tick_t, slots>::pop_expired()
+{
+	idx_t	idx = expired.head;
+
+	if (idx != count)
+	{
+		unlink(expired, idx);
+		state[idx] = TIMER_IDLE;
+	}
+	return idx;
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+bool	TimerWheel<idx_t, count, tick_t, slots>::is_scheduled(idx_t idx) const
+{
+	return idx < count && state[idx] != TIMER_IDLE;
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+void	TimerWheel<idx_t, count, tick_t, slots>::link(list_t& list, idx_t idx)
+{
+	next[idx] = count;
+	prev[idx] = list.tail;
+	if (list.tail != count)
+	{
+		next[list.tail] = idx;
+	}
+	else
+	{
+		list.head = idx;
+	}
+	list.tail = idx;
+}
+
+template <typename idx_t, uint16_t count, typename tick_t, uint16_t slots>
+void	TimerWheel<idx_t, count, tick_t, slots>::unlink(list_t& list, idx_t idx)
+{
+	if (prev[idx] != count)
+	{
+		next[prev[idx]] = next[idx];
+	}
+	else
+	{
+		list.head = next[idx];
+	}
+	if (next[idx] != count)
+	{
+		prev[next[idx]] = prev[idx];
+	}
+	else
+	{
+		list.tail = prev[idx];
+	}
+	next[idx] = count;
+	prev[idx] = count;
+}
+
+#endif // TIMER_WHEEL_HPP
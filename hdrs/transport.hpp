@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   transport.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 10:14:52 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/24 12:31:09 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#define LOOPBACK_MAX_PORTS		1024
+#define LOOPBACK_QUEUE_SIZE		1024
+#define UDP_RECEIVE_BATCH			64
+#define UDP_SEND_BATCH				16
+
+#include "shared_data.hpp"
+#include "socket.hpp"
+#include "shm_transport.hpp"
+#include "wire_codec.hpp"
+#include "ring_queue.hpp"
+
+#include <cstdint>
+
+// What a node needs from the bus: broadcast a frame, take what arrived,
+// and an fd to poll when the backend has one (-1 otherwise, the caller
+// then drains receive_batch() from its tick). Failures are counted, never
+// fatal; a transport that did not open stays closed and does nothing.
+// Whether a node hears its own frames depends on the backend, so
+// receivers keep filtering on idx_can.
+class Transport
+{
+	public:
+		Transport() : error(NULL), errors(0), dropped(0) {}
+		virtual ~Transport() {}
+		virtual bool			send_frame(const can_data_t& frame) = 0;
+		virtual uint16_t	send_frames(const can_data_t *frames, uint16_t count);
+		virtual uint16_t	receive_batch(can_data_t *frames, uint16_t max_frames) = 0;
+		virtual int				get_poll_fd() const = 0;
+		bool							is_open() const { return error == NULL; }
+		const char				*get_error() const { return error; }
+		uint64_t					get_errors() const { return errors; }
+		uint64_t					get_dropped() const { return dropped; }
+	protected:
+		const char	*error;		// why the transport did not open
+		uint64_t		errors;		// failed sends and receives
+		uint64_t		dropped;	// frames lost inside the transport
+};
+
+class UdpTransport : public Transport
+{
+	public:
+		UdpTransport(const char *multicast_ip = MULTICAST_IP, uint16_t multicast_port = MULTICAST_PORT);
+		// Sends to one group and listens on another, for nodes behind fault_relay
+		UdpTransport(const char *tx_ip, uint16_t tx_port, const char *rx_ip, uint16_t rx_port);
+		~UdpTransport();
+		bool			send_frame(const can_data_t& frame);
+		uint16_t	send_frames(const can_data_t *frames, uint16_t count);
+		uint16_t	receive_batch(can_data_t *frames, uint16_t max_frames);
+		int				get_poll_fd() const { return receiver.sock_fd; }
+	private:
+		udp_data_t																		sender;
+		udp_data_t																		receiver;
+		udp_batch_t<wire_frame_t, UDP_SEND_BATCH>			tx_batch;
+		udp_batch_t<wire_frame_t, UDP_RECEIVE_BATCH>	rx_batch;
+};
+
+// Lost frames come from the readers' cursor falling behind the ring
+class ShmTransport : public Transport
+{
+	public:
+		ShmTransport(const char *name = SHM_BUS_NAME);
+		~ShmTransport();
+		bool			send_frame(const can_data_t& frame);
+		uint16_t	receive_batch(can_data_t *frames, uint16_t max_frames);
+		int				get_poll_fd() const { return -1; }
+		bool			wait(int timeout_ms) { return is_open() && wait_shm(shm_data, timeout_ms); }
+	private:
+		shm_data_t	shm_data;
+};
+
+class LoopbackTransport;
+
+// Single-threaded in-process bus: send_frame() copies the frame straight
+// into the inbound queue of every other attached transport. A full queue
+// drops the frame for that receiver only, like a slow node on the bus.
+class LoopbackBus
+{
+	public:
+		LoopbackBus() : ports_count(0) {}
+		bool			attach(LoopbackTransport *port);
+		void			detach(LoopbackTransport *port);
+		void			broadcast(const LoopbackTransport *from, const can_data_t& frame);
+		uint16_t	get_ports_count() const { return ports_count; }
+	private:
+		LoopbackTransport	*ports[LOOPBACK_MAX_PORTS];
+		uint16_t					ports_count;
+};
+
+class LoopbackTransport : public Transport
+{
+	public:
+		LoopbackTransport(LoopbackBus& bus);
+		~LoopbackTransport();
+		bool			send_frame(const can_data_t& frame);
+		uint16_t	receive_batch(can_data_t *frames, uint16_t max_frames);
+		int				get_poll_fd() const { return -1; }
+		void			deliver(const can_data_t& frame);
+	private:
+		LoopbackBus&																bus;
+		RingQueue<can_data_t, LOOPBACK_QUEUE_SIZE>	inbound;
+};
+
+Transport	*create_transport(transport_kind_t kind, LoopbackBus *loopback_bus = NULL, uint16_t pid = 0);
+
+#endif // TRANSPORT_HPP
@@ -0,0 +1,272 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   wire_codec.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/21 09:37:12 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 09:12:40 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef WIRE_CODEC_HPP
+#define WIRE_CODEC_HPP
+
+#include "shared_data.hpp"
+#include "message_view.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Wire frame: message_type u8, idx_can u16, data_len u8, then data_len
+// payload bytes. All integers little-endian, no padding; idx is filled
+// in by the receiver and never sent.
+#define WIRE_HEADER_LEN	4
+#define WIRE_FRAME_MAX	(WIRE_HEADER_LEN + CAN_DATA_MAX_LEN)
+
+struct	wire_frame_t
+{
+	uint8_t	bytes[WIRE_FRAME_MAX];
+};
+
+// Byte-wise so the layout does not depend on the host; compilers fold
+// it into a single move on little-endian targets
+template <typename value_t>
+static inline void	store_le(uint8_t *out, value_t value)
+{
+	typedef typename std::make_unsigned<value_t>::type	unsigned_t;
+	unsigned_t	bits = static_cast<unsigned_t>(value);
+
+	for (size_t i = 0; i < sizeof(value_t); ++i)
+	{
+		out[i] = static_cast<uint8_t>(bits >> (8 * i));
+	}
+}
+
+template <typename value_t>
+static inline value_t	load_le(const uint8_t *in)
+{
+	typedef typename std::make_unsigned<value_t>::type	unsigned_t;
+	unsigned_t	bits = 0;
+
+	for (size_t i = 0; i < sizeof(value_t); ++i)
+	{
+		bits |= static_cast<unsigned_t>(static_cast<unsigned_t>(in[i]) << (8 * i));
+	}
+	return static_cast<value_t>(bits);
+}
+
+// One struct member on the wire; OFFSET is where the host struct keeps it
+template <typename struct_t, typename field_t, field_t struct_t::*member, size_t offset>
+struct	wire_field_t
+{
+	static constexpr size_t	SIZE = sizeof(field_t);
+	static constexpr size_t	OFFSET = offset;
+	static inline void	encode(const struct_t& message, uint8_t *out) { store_le<field_t>(out, message.*member); }
+	static inline void	decode(struct_t& message, const uint8_t *in) { message.*member = load_le<field_t>(in); }
+};
+
+#define WIRE_FIELD(struct_t, member)	\
+	wire_field_t<struct_t, decltype(struct_t::member), &struct_t::member, offsetof(struct_t, member)>
+
+// Field list walked recursively (the tree builds as C++11): SIZE sums the
+// fields, encode/decode advance out/in by each field in turn
+template <typename struct_t, typename... fields_t>
+struct	wire_fields_t;
+
+template <typename struct_t>
+struct	wire_fields_t<struct_t>
+{
+	static constexpr size_t	SIZE = 0;
+	static constexpr bool	is_packed_from(size_t offset) { return offset == sizeof(struct_t); }
+	static inline void	encode(const struct_t&, uint8_t *) {}
+	static inline void	decode(struct_t&, const uint8_t *) {}
+};
+
+template <typename struct_t, typename field_t, typename... rest_t>
+struct	wire_fields_t<struct_t, field_t, rest_t...>
+{
+	typedef wire_fields_t<struct_t, rest_t...>	rest_fields_t;
+	static constexpr size_t	SIZE = field_t::SIZE + rest_fields_t::SIZE;
+	static constexpr bool	is_packed_from(size_t offset)
+	{
+		return field_t::OFFSET == offset && rest_fields_t::is_packed_from(offset + field_t::SIZE);
+	}
+	static inline void	encode(const struct_t& message, uint8_t *out)
+	{
+		field_t::encode(message, out);
+		rest_fields_t::encode(message, out + field_t::SIZE);
+	}
+	static inline void	decode(struct_t& message, const uint8_t *in)
+	{
+		field_t::decode(message, in);
+		rest_fields_t::decode(message, in + field_t::SIZE);
+	}
+};
+
+// Fields laid out back to back in declaration order. SIZE and every
+// offset are compile-time constants. When the host is little-endian and
+// the packed struct already has the wire layout, IS_RAW turns encode and
+// decode into one fixed-size copy; otherwise they unroll field by field.
+// -DWIRE_CODEC_NO_RAW forces the field-wise path, for testing.
+template <typename struct_t, typename... fields_t>
+struct	WireCodec
+{
+	typedef wire_fields_t<struct_t, fields_t...>	fields_list_t;
+	static constexpr size_t	SIZE = fields_list_t::SIZE;
+	static constexpr bool	is_host_layout() { return fields_list_t::is_packed_from(0); }
+#ifdef WIRE_CODEC_NO_RAW
+	static constexpr bool	IS_RAW = false;
+#else
+	static constexpr bool	IS_RAW = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && is_host_layout();
+#endif
+	typedef std::integral_constant<bool, IS_RAW>	raw_tag_t;
+	static inline void	encode(const struct_t& message, uint8_t *out) { encode(message, out, raw_tag_t()); }
+	static inline void	decode(struct_t& message, const uint8_t *in) { decode(message, in, raw_tag_t()); }
+	private:
+		static inline void	encode(const struct_t& message, uint8_t *out, std::true_type) { memcpy(out, &message, SIZE); }
+		static inline void	encode(const struct_t& message, uint8_t *out, std::false_type) { fields_list_t::encode(message, out); }
+		static inline void	decode(struct_t& message, const uint8_t *in, std::true_type) { memcpy(&message, in, SIZE); }
+		static inline void	decode(struct_t& message, const uint8_t *in, std::false_type) { fields_list_t::decode(message, in); }
+};
+
+typedef WireCodec<ssv_message_t,
+									WIRE_FIELD(ssv_message_t, iterator),
+									WIRE_FIELD(ssv_message_t, param_num),
+									WIRE_FIELD(ssv_message_t, param_val)>		ssv_codec_t;
+typedef WireCodec<ssrv_message_t,
+									WIRE_FIELD(ssrv_message_t, param_num),
+									WIRE_FIELD(ssrv_message_t, param_val)>	ssrv_codec_t;
+typedef WireCodec<sse_message_t,
+									WIRE_FIELD(sse_message_t, error_code),
+									WIRE_FIELD(sse_message_t, param_num)>		sse_codec_t;
+
+// Payload offsets and data_len are shared with the in-place views
+static_assert(ssv_codec_t::SIZE == sizeof(ssv_message_t), "ssv_message_t wire size");
+static_assert(ssrv_codec_t::SIZE == sizeof(ssrv_message_t), "ssrv_message_t wire size");
+static_assert(sse_codec_t::SIZE == sizeof(sse_message_t), "sse_message_t wire size");
+static_assert(CAN_DATA_MAX_LEN <= UINT8_MAX, "data_len is one byte on the wire");
+
+// Every message already has its wire layout in memory: payloads move as is
+static constexpr bool	WIRE_PAYLOAD_IS_RAW = ssv_codec_t::IS_RAW && ssrv_codec_t::IS_RAW && sse_codec_t::IS_RAW;
+
+// Re-encodes count messages between a host payload and a wire payload
+template <typename codec_t, typename message_t>
+static inline void	encode_messages(const uint8_t *data, uint8_t *out, uint16_t messages_count)
+{
+	for (uint16_t i = 0; i < messages_count; ++i)
+	{
+		codec_t::encode(*view_message<message_t>(data, CAN_DATA_MAX_LEN, i * sizeof(message_t)), out + i * codec_t::SIZE);
+	}
+}
+
+template <typename codec_t, typename message_t>
+static inline void	decode_messages(const uint8_t *in, uint8_t *data, uint16_t messages_count)
+{
+	for (uint16_t i = 0; i < messages_count; ++i)
+	{
+		codec_t::decode(*encode_message<message_t>(data, CAN_DATA_MAX_LEN, i * sizeof(message_t)), in + i * codec_t::SIZE);
+	}
+}
+
+// How many messages of its type a payload of data_len holds; -1 when
+// data_len does not match the type
+static inline int16_t	get_messages_count(uint8_t message_type, const uint8_t *data, uint16_t data_len)
+{
+	int16_t	result = -1;
+
+	if (message_type == SSV_MESSAGE && data_len == ssv_codec_t::SIZE)
+	{
+		result = 1;
+	}
+	if (message_type == SSRV_MESSAGE && data_len == ssrv_codec_t::SIZE)
+	{
+		result = 1;
+	}
+	if (message_type == SSE_MESSAGE && data_len == sse_codec_t::SIZE)
+	{
+		result = 1;
+	}
+	if (message_type == SSV_PACKED_MESSAGE && data_len > 0 && data_len <= CAN_DATA_MAX_LEN
+		&& data_len == 1 + data[0] * ssv_codec_t::SIZE)
+	{
+		result = data[0];
+	}
+	return result;
+}
+
+// Payload in and out hold CAN_DATA_MAX_LEN bytes when encoding, so the
+// raw encode is one fixed-size copy
+static inline void	transcode_payload(uint8_t message_type, const uint8_t *in, uint8_t *out,
+																		uint16_t data_len, uint16_t messages_count, bool encode)
+{
+	if (WIRE_PAYLOAD_IS_RAW)
+	{
+		memcpy(out, in, encode ? CAN_DATA_MAX_LEN : data_len);
+	}
+	else
+	{
+		if (message_type == SSV_MESSAGE || message_type == SSV_PACKED_MESSAGE)
+		{
+			// The packed count byte goes through as is
+			if (message_type == SSV_PACKED_MESSAGE)
+			{
+				*out++ = *in++;
+			}
+			if (encode)
+				encode_messages<ssv_codec_t, ssv_message_t>(in, out, messages_count);
+			else
+				decode_messages<ssv_codec_t, ssv_message_t>(in, out, messages_count);
+		}
+		if (message_type == SSRV_MESSAGE && encode)
+			encode_messages<ssrv_codec_t, ssrv_message_t>(in, out, messages_count);
+		if (message_type == SSRV_MESSAGE && !encode)
+			decode_messages<ssrv_codec_t, ssrv_message_t>(in, out, messages_count);
+		if (message_type == SSE_MESSAGE && encode)
+			encode_messages<sse_codec_t, sse_message_t>(in, out, messages_count);
+		if (message_type == SSE_MESSAGE && !encode)
+			decode_messages<sse_codec_t, sse_message_t>(in, out, messages_count);
+	}
+}
+
+// Writes frame to out (WIRE_FRAME_MAX bytes) and returns the wire length,
+// 0 for a frame that is not a well-formed protocol message
+static inline uint16_t	encode_frame(const can_data_t& frame, uint8_t *out)
+{
+	int16_t		messages_count = get_messages_count(frame.message_type, frame.data, frame.data_len);
+	uint16_t	result = 0;
+
+	if (messages_count >= 0)
+	{
+		out[0] = frame.message_type;
+		store_le<uint16_t>(out + 1, frame.idx_can);
+		out[3] = static_cast<uint8_t>(frame.data_len);
+		transcode_payload(frame.message_type, frame.data, out + WIRE_HEADER_LEN, frame.data_len, messages_count, true);
+		result = WIRE_HEADER_LEN + frame.data_len;
+	}
+	return result;
+}
+
+// Rejects anything whose length, type or payload size do not agree
+static inline bool	decode_frame(const uint8_t *in, uint16_t len, can_data_t& frame)
+{
+	int16_t	messages_count = -1;
+
+	if (len >= WIRE_HEADER_LEN && len == WIRE_HEADER_LEN + in[3])
+	{
+		messages_count = get_messages_count(in[0], in + WIRE_HEADER_LEN, in[3]);
+	}
+	if (messages_count >= 0)
+	{
+		frame.message_type = in[0];
+		frame.idx_can = load_le<uint16_t>(in + 1);
+		frame.data_len = in[3];
+		transcode_payload(frame.message_type, in + WIRE_HEADER_LEN, frame.data, frame.data_len, messages_count, false);
+	}
+	return messages_count >= 0;
+}
+
+#endif // WIRE_CODEC_HPP
@@ -0,0 +1,228 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   event_loop.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/16 09:44:10 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 10:14:09 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/event_loop.hpp"
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+// wake_fd is registered under the out-of-range slot MAX_HANDLERS
+EventLoop::EventLoop() : epoll_fd(epoll_create1(EPOLL_CLOEXEC)),
+	wake_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), running(true), is_dispatching(false), has_released(false)
+{
+	epoll_event	event {};
+
+	for (uint16_t i = 0; i < MAX_HANDLERS; ++i)
+	{
+		slots[i].fd = -1;
+		slots[i].is_used = false;
+	}
+	if (is_valid())
+	{
+		event.events = EPOLLIN;
+		event.data.u32 = MAX_HANDLERS;
+		epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+	}
+}
+
+EventLoop::~EventLoop()
+{
+	if (wake_fd >= 0)
+	{
+		close(wake_fd);
+	}
+	if (epoll_fd >= 0)
+	{
+		close(epoll_fd);
+	}
+}
+
+int	EventLoop::find_slot(int fd) const
+{
+	int	result = -1;
+
+	for (uint16_t i = 0; i < MAX_HANDLERS && result < 0 && fd >= 0; ++i)
+	{
+		if (slots[i].fd == fd)
+		{
+			result = i;
+		}
+	}
+	return result;
+}
+
+int	EventLoop::find_free_slot() const
+{
+	int	result = -1;
+
+	for (uint16_t i = 0; i < MAX_HANDLERS && result < 0; ++i)
+	{
+		if (!slots[i].is_used)
+		{
+			result = i;
+		}
+	}
+	return result;
+}
+
+// Drops the handlers of slots removed during the last batch
+void	EventLoop::release_slots()
+{
+	for (uint16_t i = 0; i < MAX_HANDLERS; ++i)
+	{
+		if (slots[i].is_used && slots[i].fd < 0)
+		{
+			slots[i].handler = handler_t();
+			slots[i].is_used = false;
+		}
+	}
+	has_released = false;
+}
+
+// The fd stays owned by the caller. Returns false when the table is full
+// or epoll rejects the fd.
+bool	EventLoop::add_fd(int fd, handler_t handler, uint32_t events)
+{
+	int					slot = find_free_slot();
+	epoll_event	event {};
+	bool				result = false;
+
+	if (fd >= 0 && slot >= 0 && find_slot(fd) < 0)
+	{
+		event.events = events;
+		event.data.u32 = static_cast<uint32_t>(slot);
+		if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0)
+		{
+			slots[slot].fd = fd;
+			slots[slot].is_used = true;
+			slots[slot].handler = handler;
+			result = true;
+		}
+	}
+	return result;
+}
+
+bool	EventLoop::remove_fd(int fd)
+{
+	int		slot = find_slot(fd);
+	bool	result = false;
+
+	if (slot >= 0)
+	{
+		epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+		slots[slot].fd = -1;
+		has_released = true;
+		if (!is_dispatching)
+		{
+			release_slots();
+		}
+		result = true;
+	}
+	return result;
+}
+
+// Periodic CLOCK_MONOTONIC timerfd owned by the loop. The handler gets the
+// number of periods elapsed since the last call, so a late loop can catch
+// up instead of silently losing ticks. Returns the timer fd, -1 on failure.
+int	EventLoop::add_timer(uint32_t period_ms, timer_handler_t handler)
+{
+	int					timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	itimerspec	spec {};
+
+	spec.it_interval.tv_sec = period_ms / 1000;
+	spec.it_interval.tv_nsec = static_cast<long>(period_ms % 1000) * 1000000L;
+	spec.it_value = spec.it_interval;
+	if (timer_fd >= 0 && (period_ms == 0 || timerfd_settime(timer_fd, 0, &spec, NULL) < 0
+		|| !add_fd(timer_fd, [timer_fd, handler](uint32_t)
+		{
+			uint64_t	expirations = 0;
+
+			if (read(timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations))
+			{
+				handler(expirations);
+			}
+		})))
+	{
+		close(timer_fd);
+		timer_fd = -1;
+	}
+	return timer_fd;
+}
+
+bool	EventLoop::remove_timer(int timer_fd)
+{
+	bool	result = remove_fd(timer_fd);
+
+	if (result)
+	{
+		close(timer_fd);
+	}
+	return result;
+}
+
+// Waits once and runs the handlers of every ready fd. Returns how many
+// handlers ran.
+uint16_t	EventLoop::run_once(int timeout_ms)
+{
+	epoll_event	events[MAX_EVENTS];
+	uint64_t		wakeups;
+	uint32_t		slot;
+	uint16_t		handled = 0;
+	int					ready = epoll_wait(epoll_fd, events, MAX_EVENTS, timeout_ms);
+
+	is_dispatching = true;
+	for (int i = 0; i < ready; ++i)
+	{
+		slot = events[i].data.u32;
+		if (slot == MAX_HANDLERS)
+		{
+			if (read(wake_fd, &wakeups, sizeof(wakeups)) < 0)
+			{
+				wakeups = 0;
+			}
+		}
+		// A handler may have removed a later fd of this batch
+		else if (slots[slot].fd >= 0)
+		{
+			slots[slot].handler(events[i].events);
+			++handled;
+		}
+	}
+	is_dispatching = false;
+	if (has_released)
+	{
+		release_slots();
+	}
+	return handled;
+}
+
+// running is armed by the constructor, so a stop() issued before run()
+// starts is kept and run() returns at once
+void	EventLoop::run()
+{
+	while (running.load(std::memory_order_acquire))
+	{
+		run_once(-1);
+	}
+}
+
+void	EventLoop::stop()
+{
+	uint64_t	one = 1;
+
+	running.store(false, std::memory_order_release);
+	if (write(wake_fd, &one, sizeof(one)) < 0)
+	{
+		one = 0;
+	}
+}
@@ -0,0 +1,273 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf_scope.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 15:40:02 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/25 15:40:02 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/perf_scope.hpp"
+
+#ifdef SHARED_DATA_PERF
+
+#include <iomanip>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+struct	perf_fd_t
+{
+	int														fd;
+	volatile perf_event_mmap_page	*page;
+};
+
+// One counter group per thread, opened on the thread's first scope
+struct	perf_thread_t
+{
+	bool				is_opened;
+	bool				is_ok;
+	perf_fd_t		counters[PERF_COUNTERS];
+	~perf_thread_t();
+};
+
+struct	perf_event_t
+{
+	uint32_t	type;
+	uint64_t	config;
+};
+
+static const perf_event_t	EVENTS[PERF_COUNTERS] =
+{
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+		| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+static const char	*COUNTER_NAMES[PERF_COUNTERS] = { "cycles", "instr", "L1D miss", "LLC miss", "br miss" };
+
+static PerfScopeStats				*scopes[PERF_MAX_SCOPES];
+static std::atomic<uint16_t>	scopes_count(0);
+static std::atomic<int>				open_error(0);
+static thread_local perf_thread_t	perf_thread {};
+
+perf_thread_t::~perf_thread_t()
+{
+	for (uint8_t i = 0; i < PERF_COUNTERS && is_ok; ++i)
+	{
+		if (counters[i].page)
+			munmap(const_cast<perf_event_mmap_page *>(counters[i].page), sysconf(_SC_PAGESIZE));
+		close(counters[i].fd);
+	}
+}
+
+static int	open_counter(const perf_event_t& event, int group_fd)
+{
+	perf_event_attr	attr {};
+
+	attr.size = sizeof(attr);
+	attr.type = event.type;
+	attr.config = event.config;
+	attr.disabled = group_fd < 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+// All five in one group so they count over the same intervals; any
+// failure leaves the thread without counters and the reason in open_error
+static perf_thread_t&	get_perf_thread()
+{
+	perf_thread_t&	thread = perf_thread;
+	void						*page;
+
+	if (!thread.is_opened)
+	{
+		thread.is_opened = true;
+		thread.is_ok = true;
+		for (uint8_t i = 0; i < PERF_COUNTERS; ++i)
+		{
+			thread.counters[i].fd = -1;
+		}
+		for (uint8_t i = 0; i < PERF_COUNTERS && thread.is_ok; ++i)
+		{
+			thread.counters[i].fd = open_counter(EVENTS[i], i ? thread.counters[0].fd : -1);
+			thread.is_ok = thread.counters[i].fd >= 0;
+			if (!thread.is_ok)
+				open_error.store(errno, std::memory_order_relaxed);
+		}
+		for (uint8_t i = 0; i < PERF_COUNTERS && thread.is_ok; ++i)
+		{
+			page = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED, thread.counters[i].fd, 0);
+			thread.counters[i].page = page == MAP_FAILED ? NULL : static_cast<perf_event_mmap_page *>(page);
+		}
+		for (uint8_t i = 0; i < PERF_COUNTERS && !thread.is_ok; ++i)
+		{
+			if (thread.counters[i].fd >= 0)
+				close(thread.counters[i].fd);
+		}
+		if (thread.is_ok)
+			ioctl(thread.counters[0].fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+	return thread;
+}
+
+// rdpmc under the page's seqlock when the kernel exposes the counter to
+// user space, a read() syscall otherwise
+static uint64_t	read_counter(const perf_fd_t& counter)
+{
+	uint64_t	result = 0;
+	uint32_t	index = 0;
+	uint32_t	seq;
+	uint32_t	lo;
+	uint32_t	hi;
+	uint16_t	shift;
+
+#if defined(__x86_64__) || defined(__i386__)
+	if (counter.page && counter.page->cap_user_rdpmc)
+	{
+		do
+		{
+			seq = counter.page->lock;
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+			index = counter.page->index;
+			result = counter.page->offset;
+			if (index)
+			{
+				asm volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(index - 1));
+				shift = 64 - counter.page->pmc_width;
+				result += static_cast<uint64_t>(static_cast<int64_t>((static_cast<uint64_t>(hi) << 32 | lo) << shift) >> shift);
+			}
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+		} while (counter.page->lock != seq);
+	}
+#endif
+	if (!index && read(counter.fd, &result, sizeof(result)) != sizeof(result))
+		result = 0;
+	return result;
+}
+
+PerfScopeStats::PerfScopeStats(const char *name)
+	: name(name), calls(0), totals{}
+{
+	uint16_t	slot = scopes_count.fetch_add(1);
+
+	if (slot < PERF_MAX_SCOPES)
+		scopes[slot] = this;
+}
+
+void	PerfScopeStats::add(const uint64_t *deltas)
+{
+	calls.fetch_add(1, std::memory_order_relaxed);
+	for (uint8_t i = 0; i < PERF_COUNTERS && deltas; ++i)
+	{
+		totals[i].fetch_add(deltas[i], std::memory_order_relaxed);
+	}
+}
+
+void	PerfScopeStats::reset()
+{
+	calls.store(0, std::memory_order_relaxed);
+	for (uint8_t i = 0; i < PERF_COUNTERS; ++i)
+	{
+		totals[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+PerfScope::PerfScope(PerfScopeStats& stats)
+	: stats(stats), is_counting(get_perf_thread().is_ok)
+{
+	for (uint8_t i = 0; i < PERF_COUNTERS && is_counting; ++i)
+	{
+		start[i] = read_counter(perf_thread.counters[i]);
+	}
+}
+
+// Read in reverse so the cycles counter brackets the others
+PerfScope::~PerfScope()
+{
+	uint64_t	deltas[PERF_COUNTERS];
+
+	for (uint8_t i = PERF_COUNTERS; i > 0 && is_counting; --i)
+	{
+		deltas[i - 1] = read_counter(perf_thread.counters[i - 1]) - start[i - 1];
+	}
+	stats.add(is_counting ? deltas : NULL);
+}
+
+// Scopes in templates register once per instantiation; rows of the same
+// name are summed
+void	perf_print_report(std::ostream& out)
+{
+	uint16_t	count = scopes_count.load() < PERF_MAX_SCOPES ? scopes_count.load() : PERF_MAX_SCOPES;
+	int				error = open_error.load(std::memory_order_relaxed);
+	bool			is_first;
+	uint64_t	calls;
+	uint64_t	totals[PERF_COUNTERS];
+
+	out << "perf counters: ";
+	if (error)
+		out << "unavailable (" << strerror(error) << "), calls only" << std::endl;
+	else
+		out << "per call, inclusive of nested scopes" << std::endl;
+	out << std::setw(36) << std::left << "scope" << std::right << std::setw(12) << "calls";
+	for (uint8_t i = 0; i < PERF_COUNTERS; ++i)
+	{
+		out << std::setw(11) << COUNTER_NAMES[i];
+	}
+	out << std::setw(7) << "IPC" << std::endl;
+	for (uint16_t s = 0; s < count; ++s)
+	{
+		is_first = true;
+		for (uint16_t prev = 0; prev < s && is_first; ++prev)
+		{
+			is_first = strcmp(scopes[prev]->get_name(), scopes[s]->get_name()) != 0;
+		}
+		calls = 0;
+		memset(totals, 0, sizeof(totals));
+		for (uint16_t same = s; same < count && is_first; ++same)
+		{
+			if (!strcmp(scopes[same]->get_name(), scopes[s]->get_name()))
+			{
+				calls += scopes[same]->get_calls();
+				for (uint8_t i = 0; i < PERF_COUNTERS; ++i)
+				{
+					totals[i] += scopes[same]->get_total(i);
+				}
+			}
+		}
+		if (is_first)
+		{
+			out << std::setw(36) << std::left << scopes[s]->get_name() << std::right << std::setw(12) << calls
+					<< std::fixed << std::setprecision(2);
+			for (uint8_t i = 0; i < PERF_COUNTERS; ++i)
+			{
+				out << std::setw(11) << (calls ? static_cast<double>(totals[i]) / calls : 0.0);
+			}
+			out << std::setw(7) << (totals[PERF_CYCLES]
+				? static_cast<double>(totals[PERF_INSTRUCTIONS]) / totals[PERF_CYCLES] : 0.0) << std::endl;
+		}
+	}
+}
+
+void	perf_reset()
+{
+	uint16_t	count = scopes_count.load() < PERF_MAX_SCOPES ? scopes_count.load() : PERF_MAX_SCOPES;
+
+	for (uint16_t s = 0; s < count; ++s)
+	{
+		scopes[s]->reset();
+	}
+}
+
+#endif // SHARED_DATA_PERF
@@ -6,7 +6,7 @@
 /*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/08/04 09:51:08 by blackrider        #+#    #+#             */
-/*   Updated: 2025/08/04 09:51:12 by blackrider       ###   ########.fr       */
+/*   Updated: 2025/08/26 10:12:47 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -22,7 +22,7 @@
 using std::cout;
 using std::endl;
 
-SharedParam::SharedParam(uint16_t p_num) : param_num(p_num)
+SharedParam::SharedParam(uint16_t p_num) : ssrv_counter(0), err_code(0), param_num(p_num), new_param_value(0)
 {
 	
 }
@@ -55,13 +55,16 @@ bool	SharedParam::get_sse_m(sse_message_t& message)
 	return true;
 }
 
-bool	SharedParam::handle_ssv_m(const ssv_message_t& message, uint16_t idx, uint16_t idx_can)
+// is_conflict: the value differs but the iterator did not move forward,
+// so the tie-break in is_req_update_param_value decided
+bool	SharedParam::handle_ssv_m(const ssv_message_t& message, uint16_t idx, uint16_t idx_can, bool& is_conflict)
 {
 	bool	result = get_param_max_value() >= get_param_value();
 
+	is_conflict = false;
 	if (result)
 	{
-		if (is_req_update_param_value(message, idx, idx_can))
+		if (is_req_update_param_value(message, idx, idx_can, is_conflict))
 		{
 			// mtx_out.lock();
 			// cout << "------========++++ SSV RECEIVE ++++========------" << endl;
@@ -148,12 +151,14 @@ bool	SharedParam::add_new_param_value(int32_t new_param_val, uint8_t ssrv_atmp_c
 	return result;
 }
 
-bool	SharedParam::is_req_update_param_value(const ssv_message_t& message, uint16_t idx, uint16_t idx_can)
+bool	SharedParam::is_req_update_param_value(const ssv_message_t& message, uint16_t idx, uint16_t idx_can,
+																					bool& is_conflict)
 {
 	bool	is_req = message.param_val != get_param_value();
 	
 	if (!iterator.update_iterator(message.iterator))
 	{
+		is_conflict = is_req;
 		if (P_Iterator::check_iterators(iterator, message.iterator))
 		{
 			is_req = false;
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tick_driver.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/17 10:06:31 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/17 15:27:09 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/tick_driver.hpp"
+
+#include <cerrno>
+
+#define NS_PER_SEC	1000000000LL
+
+TickDriver::TickDriver(uint32_t period_us, bool catch_up, uint16_t max_catch_up) :
+	period_ns(static_cast<int64_t>(period_us) * 1000), catch_up(catch_up),
+	max_catch_up(max_catch_up ? max_catch_up : 1), deadline_ns(0)
+{
+	reset_stats();
+}
+
+int64_t	TickDriver::now_ns()
+{
+	timespec	ts {};
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * NS_PER_SEC + ts.tv_nsec;
+}
+
+// The first deadline is one period from now
+void	TickDriver::start()
+{
+	deadline_ns = now_ns() + period_ns;
+}
+
+void	TickDriver::reset_stats()
+{
+	stats = { 0, 0, 0, INT64_MAX, INT64_MIN, 0, 0 };
+}
+
+// Sleeps until the current deadline and returns how many ticks to run:
+// 1 on time, more when catching up after a late wakeup. Deadlines beyond
+// max_catch_up, or all of them without catch_up, are counted as missed
+// and the schedule jumps forward keeping its phase.
+uint16_t	TickDriver::wait_next()
+{
+	timespec	deadline {};
+	int64_t		now;
+	int64_t		late_ns;
+	int64_t		behind;
+	uint16_t	ticks = 1;
+
+	deadline.tv_sec = deadline_ns / NS_PER_SEC;
+	deadline.tv_nsec = deadline_ns % NS_PER_SEC;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR);
+	now = now_ns();
+	late_ns = now - deadline_ns;
+	stats.jitter_min_ns = late_ns < stats.jitter_min_ns ? late_ns : stats.jitter_min_ns;
+	stats.jitter_max_ns = late_ns > stats.jitter_max_ns ? late_ns : stats.jitter_max_ns;
+	stats.jitter_sum_ns += late_ns;
+	++stats.jitter_count;
+	behind = late_ns / period_ns;
+	if (behind > 0)
+	{
+		++stats.late_wakeups;
+		if (catch_up)
+		{
+			ticks = static_cast<uint16_t>(behind + 1 < max_catch_up ? behind + 1 : max_catch_up);
+		}
+		stats.missed += behind + 1 - ticks;
+	}
+	deadline_ns += (behind + 1) * period_ns;
+	stats.ticks += ticks;
+	return ticks;
+}
+
+int64_t	TickDriver::get_jitter_mean_ns() const
+{
+	int64_t	result = 0;
+
+	if (stats.jitter_count)
+	{
+		result = stats.jitter_sum_ns / static_cast<int64_t>(stats.jitter_count);
+	}
+	return result;
+}
@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 09:12:40 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/25 09:12:40 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/bench.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <sched.h>
+
+using namespace std;
+
+std::atomic<uint64_t>	bench_allocations(0);
+
+// Counting replacements for the global allocator; the sized and aligned
+// forms all end up here or in the default delete
+void	*operator new(size_t size)
+{
+	void	*result = malloc(size ? size : 1);
+
+	bench_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (!result)
+		throw std::bad_alloc();
+	return result;
+}
+
+void	*operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void	operator delete(void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void	operator delete[](void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void	operator delete(void *ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void	operator delete[](void *ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+bool	bench_pin_cpu(int cpu)
+{
+	cpu_set_t	set;
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void	bench_print_header()
+{
+	cout << setw(37) << left << "benchmark" << right
+			 << setw(7) << "count"
+			 << setw(11) << "ns/op" << setw(11) << "min ns"
+			 << setw(10) << "+-%" << setw(12) << "cycles/op" << setw(11) << "allocs/op" << endl;
+}
+
+void	bench_print_result(const char *name, uint16_t count, const bench_result_t& result)
+{
+	cout << setw(37) << left << name << right << setw(7);
+	// 0: the operation does not depend on count
+	if (count > 0)
+		cout << count;
+	else
+		cout << "-";
+	cout << fixed << setprecision(2)
+			 << setw(11) << result.ns_median << setw(11) << result.ns_min
+			 << setw(10) << (result.ns_median > 0 ? 100.0 * result.ns_stddev / result.ns_median : 0.0)
+			 << setw(12) << result.cycles_median << setw(11) << result.allocs_per_op << endl;
+}
@@ -0,0 +1,297 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_convergence.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 16:05:33 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/27 10:31:18 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Time to consistency over ClusterSim for a matrix of node counts and
+// loss rates: after the initial sync, BENCH_CHANGES SSRV changes are
+// posted from random nodes and each is timed until every node holds it.
+// A change the node refuses (its SSRV queue is full) is counted as
+// rejected, not as an unsettled sample.
+// P_COUNT is the ParamData template argument, so each table size is its
+// own build; rows of several builds append to one CSV.
+//   g++ -std=c++17 -O2 -DP_COUNT=32 -o bench_convergence_32
+//       test/bench_convergence.cpp test/cluster_sim.cpp test/fault_stage.cpp src/*.cpp
+//   ./bench_convergence_32 [results.csv] [results.json]
+
+#include "../hdrs/cluster_sim.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <time.h>
+
+using namespace std;
+
+#define BENCH_SEED					12345
+#define BENCH_TICK_US				20000
+#define BENCH_CHANGES				50
+#define BENCH_CHANGE_TICKS	20			// ticks between two changes
+#define BENCH_SYNC_TICKS		5000		// limit for the initial sync
+#define BENCH_SETTLE_TICKS	2000		// limit for the last change to settle
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+struct	scenario_t
+{
+	uint16_t				nodes_count;
+	const char			*loss_name;
+	fault_config_t	faults;
+};
+
+struct	change_t
+{
+	uint16_t	idx;
+	int32_t		value;
+	uint64_t	posted_us;
+};
+
+struct	result_t
+{
+	scenario_t	scenario;
+	double			sync_ms;
+	double			p50_ms;
+	double			p99_ms;
+	double			max_ms;
+	uint16_t		settled;
+	uint16_t		rejected;
+	uint64_t		ssv_frames;
+	uint64_t		ssrv_frames;
+	uint64_t		sse_frames;
+	uint64_t		wire_bytes;
+	double			cpu_us_per_node_s;	// CPU per node per simulated second
+};
+
+static const uint16_t	NODES[] = { 3, 10, 50 };
+static const scenario_t	LOSSES[] =
+{
+	{ 0, "none", { 1000, 1000, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } },
+	{ 0, "5%", { 1000, 1000, 0, 0.05, 0.0, 0.0, 0.0, 0.0, 0.0 } },
+	{ 0, "20%", { 1000, 1000, 0, 0.2, 0.0, 0.0, 0.0, 0.0, 0.0 } },
+	{ 0, "burst", { 1000, 1000, 0, 0.01, 0.02, 0.2, 0.9, 0.0, 0.0 } },
+};
+
+static double	cpu_us()
+{
+	timespec	ts;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Nearest rank on sorted values
+static double	percentile(const vector<double>& sorted, double p)
+{
+	double	result = 0.0;
+
+	if (!sorted.empty())
+		result = sorted[min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+	return result;
+}
+
+static void	init_nodes(ClusterSim& sim)
+{
+	for (uint16_t n = 0; n < sim.get_nodes_count(); ++n)
+	{
+		sim.select_node(n);
+		sim.get_param_data(n).set_param_max_value(INT32_MAX);
+		for (uint16_t i = 0; i < P_COUNT; ++i)
+		{
+			sim.get_param_data(n).set_param_value(i, i, 1000 + n * 7 + i);
+			sim.get_shared_data(n).set_param_num(i);
+			sim.get_shared_data(n).set_iterator(i, 0);
+		}
+	}
+}
+
+static bool	is_settled(ClusterSim& sim, const change_t& change)
+{
+	bool	result = true;
+
+	for (uint16_t n = 0; n < sim.get_nodes_count() && result; ++n)
+	{
+		result = sim.get_param_data(n).get_param_value(change.idx) == static_cast<uint32_t>(change.value);
+	}
+	return result;
+}
+
+// Settled changes leave pending and add their latency to latencies_ms
+static void	check_changes(ClusterSim& sim, vector<change_t>& pending, vector<double>& latencies_ms)
+{
+	size_t	kept = 0;
+
+	for (size_t i = 0; i < pending.size(); ++i)
+	{
+		if (is_settled(sim, pending[i]))
+			latencies_ms.push_back((sim.get_time_us() - pending[i].posted_us) / 1e3);
+		else
+			pending[kept++] = pending[i];
+	}
+	pending.resize(kept);
+}
+
+static result_t	run_scenario(const scenario_t& scenario)
+{
+	ClusterSim::config_t	config {};
+	ClusterSim						*sim;
+	ClusterSim::stats_t		before;
+	SimRng								rng(BENCH_SEED);
+	vector<change_t>			pending;
+	vector<double>				latencies_ms;
+	uint64_t							start_us;
+	uint64_t							deadline_us;
+	double								start_cpu_us;
+	change_t							change;
+	result_t							result {};
+
+	config.nodes_count = scenario.nodes_count;
+	config.tick_us = BENCH_TICK_US;
+	config.seed = BENCH_SEED;
+	config.tx_frames = 4;
+	config.tx_budget = { 0, 4, 2, 1 };
+	config.payload_mtu = CAN_DATA_MAX_LEN;
+	config.faults = scenario.faults;
+	sim = new ClusterSim(config);
+	init_nodes(*sim);
+	result.scenario = scenario;
+	sim->run_until_converged(static_cast<uint64_t>(BENCH_SYNC_TICKS) * BENCH_TICK_US);
+	result.sync_ms = sim->get_time_us() / 1e3;
+	before = sim->get_stats();
+	start_us = sim->get_time_us();
+	start_cpu_us = cpu_us();
+	for (uint16_t k = 0; k < BENCH_CHANGES; ++k)
+	{
+		change = { static_cast<uint16_t>(k % P_COUNT), 100000 + k, sim->get_time_us() };
+		if (sim->post_ssrv(rng.below(scenario.nodes_count), sim->get_param_data(0).get_param_num(change.idx), change.value))
+			pending.push_back(change);
+		else
+			++result.rejected;
+		for (uint16_t t = 0; t < BENCH_CHANGE_TICKS; ++t)
+		{
+			sim->run_ticks(1);
+			check_changes(*sim, pending, latencies_ms);
+		}
+	}
+	deadline_us = sim->get_time_us() + static_cast<uint64_t>(BENCH_SETTLE_TICKS) * BENCH_TICK_US;
+	while (!pending.empty() && sim->get_time_us() < deadline_us)
+	{
+		sim->run_ticks(1);
+		check_changes(*sim, pending, latencies_ms);
+	}
+	result.cpu_us_per_node_s = (cpu_us() - start_cpu_us) / scenario.nodes_count
+		/ ((sim->get_time_us() - start_us) / 1e6);
+	sort(latencies_ms.begin(), latencies_ms.end());
+	result.p50_ms = percentile(latencies_ms, 0.5);
+	result.p99_ms = percentile(latencies_ms, 0.99);
+	result.max_ms = latencies_ms.empty() ? 0.0 : latencies_ms.back();
+	result.settled = latencies_ms.size();
+	result.ssv_frames = sim->get_stats().frames_by_type[SSV_MESSAGE] - before.frames_by_type[SSV_MESSAGE]
+		+ sim->get_stats().frames_by_type[SSV_PACKED_MESSAGE] - before.frames_by_type[SSV_PACKED_MESSAGE];
+	result.ssrv_frames = sim->get_stats().frames_by_type[SSRV_MESSAGE] - before.frames_by_type[SSRV_MESSAGE];
+	result.sse_frames = sim->get_stats().frames_by_type[SSE_MESSAGE] - before.frames_by_type[SSE_MESSAGE];
+	result.wire_bytes = sim->get_stats().wire_bytes - before.wire_bytes;
+	delete sim;
+	return result;
+}
+
+static void	print_header()
+{
+	cout << setw(8) << "p_count" << setw(7) << "nodes" << setw(7) << "loss"
+			 << setw(10) << "sync ms" << setw(9) << "p50 ms" << setw(9) << "p99 ms" << setw(9) << "max ms"
+			 << setw(9) << "settled" << setw(5) << "rej" << setw(9) << "ssv" << setw(8) << "ssrv" << setw(6) << "sse"
+			 << setw(11) << "wire B" << setw(13) << "cpu us/n/s" << endl;
+}
+
+static void	print_result(const result_t& result)
+{
+	cout << setw(8) << P_COUNT << setw(7) << result.scenario.nodes_count << setw(7) << result.scenario.loss_name
+			 << fixed << setprecision(1)
+			 << setw(10) << result.sync_ms << setw(9) << result.p50_ms << setw(9) << result.p99_ms
+			 << setw(9) << result.max_ms
+			 << setw(6) << result.settled << "/" << setw(2) << BENCH_CHANGES << setw(5) << result.rejected
+			 << setw(9) << result.ssv_frames << setw(8) << result.ssrv_frames << setw(6) << result.sse_frames
+			 << setw(11) << result.wire_bytes << setw(13) << result.cpu_us_per_node_s << endl;
+}
+
+// The header goes only into a new or empty file
+static void	write_csv(const char *path, const vector<result_t>& results)
+{
+	ifstream	existing(path);
+	bool			is_new = existing.peek() == ifstream::traits_type::eof();
+	ofstream	out(path, ios::app);
+
+	if (is_new)
+		out << "p_count,nodes,loss,changes,settled,rejected,sync_ms,p50_ms,p99_ms,max_ms,"
+				<< "ssv_frames,ssrv_frames,sse_frames,wire_bytes,cpu_us_per_node_s\n";
+	for (const result_t& result : results)
+	{
+		out << P_COUNT << "," << result.scenario.nodes_count << "," << result.scenario.loss_name << ","
+				<< BENCH_CHANGES << "," << result.settled << "," << result.rejected << "," << result.sync_ms << ","
+				<< result.p50_ms << "," << result.p99_ms << "," << result.max_ms << ","
+				<< result.ssv_frames << "," << result.ssrv_frames << "," << result.sse_frames << ","
+				<< result.wire_bytes << "," << result.cpu_us_per_node_s << "\n";
+	}
+}
+
+static void	write_json(const char *path, const vector<result_t>& results)
+{
+	ofstream	out(path);
+
+	out << "[\n";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const result_t&	result = results[i];
+
+		out << "  {\"p_count\": " << P_COUNT << ", \"nodes\": " << result.scenario.nodes_count
+				<< ", \"loss\": \"" << result.scenario.loss_name << "\", \"changes\": " << BENCH_CHANGES
+				<< ", \"settled\": " << result.settled << ", \"rejected\": " << result.rejected
+				<< ", \"sync_ms\": " << result.sync_ms
+				<< ", \"p50_ms\": " << result.p50_ms << ", \"p99_ms\": " << result.p99_ms
+				<< ", \"max_ms\": " << result.max_ms << ", \"ssv_frames\": " << result.ssv_frames
+				<< ", \"ssrv_frames\": " << result.ssrv_frames << ", \"sse_frames\": " << result.sse_frames
+				<< ", \"wire_bytes\": " << result.wire_bytes
+				<< ", \"cpu_us_per_node_s\": " << result.cpu_us_per_node_s << "}"
+				<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	out << "]\n";
+}
+
+int	main(int argc, char *argv[])
+{
+	vector<result_t>	results;
+	scenario_t				scenario;
+
+	print_header();
+	for (uint16_t n : NODES)
+	{
+		for (const scenario_t& loss : LOSSES)
+		{
+			scenario = loss;
+			scenario.nodes_count = n;
+			results.push_back(run_scenario(scenario));
+			print_result(results.back());
+		}
+	}
+	if (argc > 1)
+		write_csv(argv[1], results);
+	if (argc > 2)
+		write_json(argv[2], results);
+	return 0;
+}
@@ -0,0 +1,205 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_micro.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 09:12:40 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/25 15:40:02 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Hot paths of SharedData, FSQueue, P_Iterator and ParamData through the
+// bench.hpp harness, at several counts. SharedParam reads the global
+// ParamData<P_COUNT>, so build with P_COUNT raised to the largest count:
+//   g++ -std=c++17 -O2 -DP_COUNT=4096 test/bench_micro.cpp test/bench.cpp src/*.cpp
+//   ./a.out [cpu]
+
+#include "../hdrs/bench.hpp"
+#include "../hdrs/shared_data.hpp"
+#include "../hdrs/client_server_shared_setpoint.hpp"
+#include "../hdrs/queue.hpp"
+#include "../hdrs/p_iterator.hpp"
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+using namespace std;
+
+#define BENCH_FRAMES		4096		// power of two, ops pick frames[i & mask]
+#define BENCH_TX_FRAMES	4
+#define PARAM_STEP			3
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+static const bench_config_t	CONFIG = { 2, 11, 100000 };
+static const tx_budget_t		TX_BUDGET = { 0, 4, 2, 1 };
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+template <uint16_t count>
+void	init_bench_data(SharedData<count> *shared_data, ParamData<count> *local_param_data)
+{
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		param_data->set_param_value(i, i * PARAM_STEP, rand() % 9999 + 2077);
+		local_param_data->set_param_value(i, i * PARAM_STEP, rand() % 9999 + 2077);
+		shared_data->set_param_num(i * PARAM_STEP);
+		shared_data->set_iterator(i, 0);
+	}
+}
+
+// Frames of one type about random parameters of the table
+void	fill_frames(can_data_t *frames, uint8_t message_type, uint16_t count)
+{
+	ssv_message_t		ssv_message;
+	ssrv_message_t	ssrv_message;
+	sse_message_t		sse_message;
+	uint16_t				param_num;
+
+	for (uint32_t i = 0; i < BENCH_FRAMES; ++i)
+	{
+		param_num = (rand() % count) * PARAM_STEP;
+		ssv_message = { static_cast<int16_t>(i), param_num, rand() % 9999 + 2077 };
+		ssrv_message = { static_cast<int16_t>(param_num), rand() % 9999 + 2077 };
+		sse_message = { 1, param_num };
+		frames[i] = can_data_t {};
+		frames[i].message_type = message_type;
+		frames[i].idx_can = 1;
+		if (message_type == SSV_MESSAGE)
+			memcpy(frames[i].data, &ssv_message, sizeof(ssv_message));
+		if (message_type == SSRV_MESSAGE)
+			memcpy(frames[i].data, &ssrv_message, sizeof(ssrv_message));
+		if (message_type == SSE_MESSAGE)
+			memcpy(frames[i].data, &sse_message, sizeof(sse_message));
+		frames[i].data_len = message_type == SSV_MESSAGE ? sizeof(ssv_message)
+			: message_type == SSRV_MESSAGE ? sizeof(ssrv_message) : sizeof(sse_message);
+		if (message_type == SSV_PACKED_MESSAGE)
+		{
+			frames[i].data[0] = (CAN_DATA_MAX_LEN - 1) / sizeof(ssv_message);
+			for (uint8_t j = 0; j < frames[i].data[0]; ++j)
+			{
+				ssv_message.param_num = (rand() % count) * PARAM_STEP;
+				memcpy(frames[i].data + 1 + j * sizeof(ssv_message), &ssv_message, sizeof(ssv_message));
+			}
+			frames[i].data_len = 1 + frames[i].data[0] * sizeof(ssv_message);
+		}
+	}
+}
+
+template <uint16_t count>
+void	bench_handle(const char *name, SharedData<count> *shared_data, can_data_t *frames, uint8_t message_type)
+{
+	fill_frames(frames, message_type, count);
+	bench_print_result(name, count, bench_run(CONFIG, [&](uint64_t i)
+	{
+		bench_keep(shared_data->handle_messages(frames[i & (BENCH_FRAMES - 1)]));
+	}));
+}
+
+template <uint16_t count>
+void	bench_shared_data(can_data_t *frames, uint16_t *p_nums)
+{
+	SharedData<count>	*shared_data = new SharedData<count>();
+	ParamData<count>	*local_param_data = new ParamData<count>();
+	can_data_t				out[BENCH_TX_FRAMES];
+
+	init_bench_data(shared_data, local_param_data);
+	shared_data->set_payload_mtu(CAN_DATA_MAX_LEN);
+	bench_print_result("SharedData::get_messages (tick)", count, bench_run(CONFIG, [&](uint64_t)
+	{
+		shared_data->period_counter();
+		bench_keep(shared_data->get_messages(out, BENCH_TX_FRAMES, TX_BUDGET));
+	}));
+	bench_handle("SharedData::handle_messages ssv", shared_data, frames, SSV_MESSAGE);
+	bench_handle("SharedData::handle_messages packed", shared_data, frames, SSV_PACKED_MESSAGE);
+	bench_handle("SharedData::handle_messages ssrv", shared_data, frames, SSRV_MESSAGE);
+	bench_handle("SharedData::handle_messages sse", shared_data, frames, SSE_MESSAGE);
+	for (uint32_t i = 0; i < BENCH_FRAMES; ++i)
+	{
+		p_nums[i] = (rand() % count) * PARAM_STEP;
+	}
+	bench_print_result("SharedData::get_idx", count, bench_run(CONFIG, [&](uint64_t i)
+	{
+		bench_keep(shared_data->test_get_idx(p_nums[i & (BENCH_FRAMES - 1)]));
+	}));
+	bench_print_result("SharedData::check_ssrv_end_counters", count, bench_run(CONFIG, [&](uint64_t)
+	{
+		bench_keep(shared_data->test_check_ssrv_end_counters());
+	}));
+	bench_print_result("ParamData::get_param_value", count, bench_run(CONFIG, [&](uint64_t i)
+	{
+		bench_keep(local_param_data->get_param_value(p_nums[i & (BENCH_FRAMES - 1)] / PARAM_STEP));
+	}));
+	bench_print_result("ParamData::get_param_idx", count, bench_run(CONFIG, [&](uint64_t i)
+	{
+		bench_keep(local_param_data->get_param_idx(p_nums[i & (BENCH_FRAMES - 1)]));
+	}));
+	delete local_param_data;
+	delete shared_data;
+}
+
+// Queue of the size SharedData<count> gives its SSRV/SSE services
+template <uint16_t count>
+void	bench_queue()
+{
+	static const uint16_t	QUEUE_SIZE = SharedDataTraits<count>::QUEUE_SIZE;
+	FSQueue<ssrv_message_t, QUEUE_SIZE>	*queue = new FSQueue<ssrv_message_t, QUEUE_SIZE>();
+	ssrv_message_t	message { 1, 2 };
+
+	bench_print_result("FSQueue::push + pop", count, bench_run(CONFIG, [&](uint64_t)
+	{
+		queue->push(message);
+		bench_keep(queue->pop(message));
+	}));
+	while (queue->push(message))
+	{
+	}
+	bench_print_result("FSQueue::swap (middle, full)", count, bench_run(CONFIG, [&](uint64_t)
+	{
+		queue->swap(QUEUE_SIZE / 2);
+		bench_keep(*queue);
+	}));
+	delete queue;
+}
+
+template <uint16_t count>
+void	bench_count(can_data_t *frames, uint16_t *p_nums)
+{
+	static_assert(count <= P_COUNT, "build with -DP_COUNT >= largest bench count");
+	bench_shared_data<count>(frames, p_nums);
+	bench_queue<count>();
+}
+
+int	main(int argc, char *argv[])
+{
+	can_data_t	*frames = new can_data_t[BENCH_FRAMES];
+	uint16_t		*p_nums = new uint16_t[BENCH_FRAMES];
+	int					cpu = argc > 1 ? atoi(argv[1]) : 0;
+
+	srand(2077);
+	param_data = new ParamData<P_COUNT>();
+	param_data->set_param_max_value(INT32_MAX);
+	if (!bench_pin_cpu(cpu))
+		cout << "could not pin to cpu " << cpu << ", results may be noisy" << endl;
+	bench_print_header();
+	bench_print_result("P_Iterator::check_iterators", 0, bench_run(CONFIG, [&](uint64_t i)
+	{
+		bench_keep(P_Iterator::check_iterators(static_cast<uint16_t>(i), static_cast<uint16_t>(i * 7)));
+	}));
+	bench_count<100>(frames, p_nums);
+	bench_count<1024>(frames, p_nums);
+	bench_count<4096>(frames, p_nums);
+	perf_print_report(cout);
+	delete param_data;
+	delete[] p_nums;
+	delete[] frames;
+	return 0;
+}
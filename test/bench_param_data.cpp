@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_param_data.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/12 10:31:52 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/12 13:15:06 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Multi-reader contention on ParamData: lock-free versioned slots against
+// a global-mutex baseline, one writer thread and 1..8 reader threads.
+//   g++ -std=c++17 -O2 -pthread test/bench_param_data.cpp
+
+#include "../hdrs/client_server_shared_setpoint.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+#define BENCH_MS			300
+#define MAX_READERS		8
+
+volatile uint64_t	bench_sink;
+
+// What ParamData would look like with one mutex guarding the whole table
+template <uint16_t count>
+class MutexParamData
+{
+	public:
+		void	set_param_value(uint16_t idx, uint16_t p_num, uint32_t p_val)
+		{
+			lock_guard<mutex>	lock(mtx);
+
+			p_data[idx] = { p_num, p_val };
+		}
+		uint32_t	get_param_value(uint16_t idx)
+		{
+			lock_guard<mutex>	lock(mtx);
+
+			return p_data[idx].p_val;
+		}
+	private:
+		struct	param_t
+		{
+			uint16_t	p_num;
+			uint32_t	p_val;
+		};
+		mutex		mtx;
+		param_t	p_data[count] {};
+};
+
+template <typename data_t>
+void	run_bench(const string& name, uint32_t readers)
+{
+	data_t						*param_data = new data_t();
+	atomic<bool>			stop(false);
+	atomic<uint64_t>	reads(0);
+	uint64_t					writes = 0;
+	vector<thread>		threads;
+
+	for (uint32_t r = 0; r < readers; ++r)
+	{
+		threads.push_back(thread([&, r]()
+		{
+			uint64_t	local_reads = 0;
+			uint64_t	sum = 0;
+			uint16_t	idx = r;
+
+			while (!stop.load(memory_order_relaxed))
+			{
+				for (int i = 0; i < 64; ++i)
+				{
+					sum += param_data->get_param_value(idx);
+					idx = (idx + 7) % P_COUNT;
+				}
+				local_reads += 64;
+			}
+			bench_sink = sum;
+			reads.fetch_add(local_reads);
+		}));
+	}
+	thread	writer([&]()
+	{
+		uint16_t	idx = 0;
+
+		while (!stop.load(memory_order_relaxed))
+		{
+			param_data->set_param_value(idx, idx, writes);
+			idx = (idx + 1) % P_COUNT;
+			++writes;
+		}
+	});
+	this_thread::sleep_for(chrono::milliseconds(BENCH_MS));
+	stop.store(true);
+	writer.join();
+	for (thread& reader : threads)
+	{
+		reader.join();
+	}
+	cout << setw(20) << left << name << right
+			 << setw(8) << readers
+			 << setw(16) << fixed << setprecision(1) << reads.load() / (BENCH_MS * 1000.0)
+			 << setw(16) << writes / (BENCH_MS * 1000.0) << endl;
+	delete param_data;
+}
+
+int	main()
+{
+	cout << setw(20) << left << "table" << right
+			 << setw(8) << "readers"
+			 << setw(16) << "reads M/s"
+			 << setw(16) << "writes M/s"
+			 << "   (" << thread::hardware_concurrency() << " cpus)" << endl;
+	for (uint32_t readers = 1; readers <= MAX_READERS; readers *= 2)
+	{
+		run_bench<MutexParamData<P_COUNT>>("global mutex", readers);
+		run_bench<ParamData<P_COUNT>>("ParamData", readers);
+	}
+	return 0;
+}
@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_queue.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/09 16:10:44 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/09 17:58:21 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Throughput of FSQueue against the RingQueue policies.
+//   g++ -std=c++17 -O2 -pthread test/bench_queue.cpp
+
+#include "../hdrs/queue.hpp"
+#include "../hdrs/ring_queue.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+#define QUEUE_ITEMS		64
+#define BATCH_ITEMS		32
+#define SINGLE_OPS		20000000
+#define THREAD_OPS		4000000
+#define PRODUCERS			4
+
+volatile uint64_t	bench_sink;
+
+// FSQueue behind a mutex, the baseline for the threaded runs
+template <typename data_t, uint16_t size>
+class LockedFSQueue
+{
+	public:
+		bool	push(const data_t& item)
+		{
+			lock_guard<mutex>	lock(mtx);
+
+			return queue.push(item);
+		}
+		bool	pop(data_t& item)
+		{
+			lock_guard<mutex>	lock(mtx);
+
+			return queue.pop(item);
+		}
+	private:
+		mutex								mtx;
+		FSQueue<data_t, size>	queue;
+};
+
+void	print_result(const string& name, double ns, uint64_t ops)
+{
+	cout << setw(28) << left << name << right
+			 << setw(12) << fixed << setprecision(2) << ns / ops << " ns/op"
+			 << setw(12) << setprecision(1) << ops / ns * 1000.0 << " Mops/s" << endl;
+}
+
+template <typename queue_t>
+void	bench_single(const string& name)
+{
+	queue_t		*queue = new queue_t();
+	uint32_t	item = 0;
+	uint64_t	sum = 0;
+	auto			start = chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < SINGLE_OPS / BATCH_ITEMS; ++i)
+	{
+		for (uint32_t j = 0; j < BATCH_ITEMS; ++j)
+		{
+			queue->push(i + j);
+		}
+		for (uint32_t j = 0; j < BATCH_ITEMS; ++j)
+		{
+			queue->pop(item);
+			sum += item;
+		}
+	}
+	chrono::duration<double, nano>	elapsed = chrono::steady_clock::now() - start;
+	bench_sink = sum;
+	print_result(name, elapsed.count(), 2ull * SINGLE_OPS);
+	delete queue;
+}
+
+template <typename queue_t>
+void	bench_threads(const string& name, uint32_t producers)
+{
+	queue_t					*queue = new queue_t();
+	vector<thread>	threads;
+	uint32_t				per_producer = THREAD_OPS / producers;
+	uint32_t				received = 0;
+	uint32_t				item = 0;
+	auto						start = chrono::steady_clock::now();
+
+	for (uint32_t p = 0; p < producers; ++p)
+	{
+		threads.push_back(thread([queue, per_producer]()
+		{
+			for (uint32_t i = 0; i < per_producer; ++i)
+			{
+				while (!queue->push(i))
+				{
+					this_thread::yield();
+				}
+			}
+		}));
+	}
+	while (received < per_producer * producers)
+	{
+		if (queue->pop(item))
+		{
+			++received;
+		}
+		else
+		{
+			this_thread::yield();
+		}
+	}
+	for (thread& producer : threads)
+	{
+		producer.join();
+	}
+	chrono::duration<double, nano>	elapsed = chrono::steady_clock::now() - start;
+	print_result(name, elapsed.count(), received);
+	delete queue;
+}
+
+int	main()
+{
+	cout << "single thread, push/pop in batches of " << BATCH_ITEMS << endl;
+	bench_single<FSQueue<uint32_t, QUEUE_ITEMS>>("FSQueue");
+	bench_single<RingQueue<uint32_t, QUEUE_ITEMS, QUEUE_SINGLE_THREAD>>("RingQueue single thread");
+	bench_single<RingQueue<uint32_t, QUEUE_ITEMS, QUEUE_SPSC>>("RingQueue SPSC");
+	bench_single<RingQueue<uint32_t, QUEUE_ITEMS, QUEUE_MPSC>>("RingQueue MPSC");
+	cout << endl << "1 producer, 1 consumer (" << thread::hardware_concurrency() << " cpus)" << endl;
+	bench_threads<LockedFSQueue<uint32_t, QUEUE_ITEMS>>("FSQueue + mutex", 1);
+	bench_threads<RingQueue<uint32_t, QUEUE_ITEMS, QUEUE_SPSC>>("RingQueue SPSC", 1);
+	bench_threads<RingQueue<uint32_t, QUEUE_ITEMS, QUEUE_MPSC>>("RingQueue MPSC", 1);
+	cout << endl << PRODUCERS << " producers, 1 consumer" << endl;
+	bench_threads<LockedFSQueue<uint32_t, QUEUE_ITEMS>>("FSQueue + mutex", PRODUCERS);
+	bench_threads<RingQueue<uint32_t, QUEUE_ITEMS, QUEUE_MPSC>>("RingQueue MPSC", PRODUCERS);
+	return 0;
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_shared_data.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/06 11:02:37 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/06 13:20:11 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Scaling benchmark for SharedData<count>: per-tick get_messages and
+// per-message handle_messages cost for 100 .. 4096 parameters.
+// SharedParam reads values through the global ParamData<P_COUNT>, so build
+// it with P_COUNT raised to the largest count measured:
+//   g++ -std=c++17 -O2 -DP_COUNT=4096 test/bench_shared_data.cpp src/*.cpp
+
+#include "../hdrs/shared_data.hpp"
+#include "../hdrs/client_server_shared_setpoint.hpp"
+#include "../hdrs/test.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+
+using namespace std;
+
+#define BENCH_TICKS			200000
+#define BENCH_MESSAGES	200000
+#define BENCH_FRAMES		4096
+#define PARAM_STEP			3
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+template <uint16_t count>
+void	init_bench_data(SharedData<count> *shared_data)
+{
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		param_data->set_param_value(i, i * PARAM_STEP, rand() % 9999 + 2077);
+	}
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		shared_data->set_param_num(i * PARAM_STEP);
+		shared_data->set_iterator(i, 0);
+	}
+}
+
+template <uint16_t count>
+double	bench_get_messages(SharedData<count> *shared_data)
+{
+	can_data_t	can_data {};
+	uint32_t		sent = 0;
+	auto				start = chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < BENCH_TICKS; ++i)
+	{
+		shared_data->period_counter();
+		sent += shared_data->get_messages(can_data);
+	}
+	chrono::duration<double, nano>	elapsed = chrono::steady_clock::now() - start;
+	if (!sent)
+	{
+		cout << "no messages sent" << endl;
+	}
+	return elapsed.count() / BENCH_TICKS;
+}
+
+template <uint16_t count>
+double	bench_handle_messages(SharedData<count> *shared_data, can_data_t *frames)
+{
+	ssv_message_t	message;
+
+	for (uint32_t i = 0; i < BENCH_FRAMES; ++i)
+	{
+		message.iterator = i;
+		message.param_num = (rand() % count) * PARAM_STEP;
+		message.param_val = rand() % 9999 + 2077;
+		frames[i].message_type = SSV_MESSAGE;
+		frames[i].data_len = sizeof(ssv_message_t);
+		frames[i].idx = 0;
+		frames[i].idx_can = 1;
+		memcpy(frames[i].data, &message, sizeof(ssv_message_t));
+	}
+	auto	start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < BENCH_MESSAGES; ++i)
+	{
+		shared_data->handle_messages(frames[i % BENCH_FRAMES]);
+	}
+	chrono::duration<double, nano>	elapsed = chrono::steady_clock::now() - start;
+	return elapsed.count() / BENCH_MESSAGES;
+}
+
+template <uint16_t count>
+void	run_bench(can_data_t *frames)
+{
+	static_assert(count <= P_COUNT, "build with -DP_COUNT >= largest bench count");
+	SharedData<count>	*shared_data = new SharedData<count>();
+
+	init_bench_data(shared_data);
+	double	tick_ns = bench_get_messages(shared_data);
+	double	handle_ns = bench_handle_messages(shared_data, frames);
+	cout << setw(8) << count
+			 << setw(12) << sizeof(SharedData<count>)
+			 << setw(20) << fixed << setprecision(1) << tick_ns
+			 << setw(24) << handle_ns << endl;
+	delete shared_data;
+}
+
+int	main()
+{
+	can_data_t	*frames = new can_data_t[BENCH_FRAMES];
+
+	srand(2077);
+	param_data = new ParamData<P_COUNT>();
+	cout << setw(8) << "count"
+			 << setw(12) << "bytes"
+			 << setw(20) << "get_messages ns"
+			 << setw(24) << "handle_messages ns" << endl;
+	run_bench<100>(frames);
+	run_bench<254>(frames);
+	run_bench<255>(frames);
+	run_bench<512>(frames);
+	run_bench<1024>(frames);
+	run_bench<2048>(frames);
+	run_bench<4096>(frames);
+	delete[] frames;
+	delete param_data;
+	return 0;
+}
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_wire_codec.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/21 14:20:55 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/21 18:04:29 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Wire codec against raw memcpy of can_data_t: ns per frame for encode
+// and decode, and bytes per frame on the wire, for each message type.
+//   g++ -std=c++17 -O2 test/bench_wire_codec.cpp src/*.cpp
+
+#include "../hdrs/wire_codec.hpp"
+#include "../hdrs/client_server_shared_setpoint.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+
+using namespace std;
+
+#define BENCH_FRAMES	1024
+#define BENCH_ROUNDS	4000
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+volatile uint64_t		bench_sink;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void	fill_frames(can_data_t *frames, uint8_t message_type)
+{
+	ssv_message_t		ssv_message;
+	ssrv_message_t	ssrv_message;
+	sse_message_t		sse_message;
+
+	for (uint16_t i = 0; i < BENCH_FRAMES; ++i)
+	{
+		frames[i] = can_data_t {};
+		frames[i].message_type = message_type;
+		frames[i].idx_can = rand() % 100;
+		ssv_message = { static_cast<int16_t>(rand()), static_cast<uint16_t>(rand()), rand() };
+		ssrv_message = { static_cast<int16_t>(rand()), rand() };
+		sse_message = { static_cast<int8_t>(rand()), static_cast<uint16_t>(rand()) };
+		if (message_type == SSV_MESSAGE)
+		{
+			memcpy(frames[i].data, &ssv_message, sizeof(ssv_message));
+			frames[i].data_len = sizeof(ssv_message);
+		}
+		if (message_type == SSRV_MESSAGE)
+		{
+			memcpy(frames[i].data, &ssrv_message, sizeof(ssrv_message));
+			frames[i].data_len = sizeof(ssrv_message);
+		}
+		if (message_type == SSE_MESSAGE)
+		{
+			memcpy(frames[i].data, &sse_message, sizeof(sse_message));
+			frames[i].data_len = sizeof(sse_message);
+		}
+		if (message_type == SSV_PACKED_MESSAGE)
+		{
+			frames[i].data[0] = (CAN_DATA_MAX_LEN - 1) / sizeof(ssv_message);
+			for (uint8_t j = 0; j < frames[i].data[0]; ++j)
+			{
+				memcpy(frames[i].data + 1 + j * sizeof(ssv_message), &ssv_message, sizeof(ssv_message));
+			}
+			frames[i].data_len = 1 + frames[i].data[0] * sizeof(ssv_message);
+		}
+	}
+}
+
+template <typename func_t>
+double	bench_ns(func_t func)
+{
+	auto	start = chrono::steady_clock::now();
+
+	for (uint32_t r = 0; r < BENCH_ROUNDS; ++r)
+	{
+		for (uint16_t i = 0; i < BENCH_FRAMES; ++i)
+		{
+			func(i);
+		}
+	}
+	chrono::duration<double, nano>	elapsed = chrono::steady_clock::now() - start;
+	return elapsed.count() / (static_cast<double>(BENCH_ROUNDS) * BENCH_FRAMES);
+}
+
+void	bench_type(const char *name, uint8_t message_type)
+{
+	static can_data_t		frames[BENCH_FRAMES];
+	static can_data_t		decoded[BENCH_FRAMES];
+	static wire_frame_t	wire[BENCH_FRAMES];
+	static can_data_t		raw[BENCH_FRAMES];
+	uint16_t	wire_len[BENCH_FRAMES];
+	double		raw_ns;
+	double		encode_ns;
+	double		decode_ns;
+
+	fill_frames(frames, message_type);
+	raw_ns = bench_ns([&](uint16_t i)
+	{
+		memcpy(&raw[i], &frames[i], sizeof(can_data_t));
+		bench_sink += raw[i].data[0];
+	});
+	encode_ns = bench_ns([&](uint16_t i)
+	{
+		wire_len[i] = encode_frame(frames[i], wire[i].bytes);
+		bench_sink += wire[i].bytes[WIRE_HEADER_LEN];
+	});
+	decode_ns = bench_ns([&](uint16_t i)
+	{
+		bench_sink += decode_frame(wire[i].bytes, wire_len[i], decoded[i]);
+	});
+	for (uint16_t i = 0; i < BENCH_FRAMES; ++i)
+	{
+		if (memcmp(decoded[i].data, frames[i].data, frames[i].data_len) || decoded[i].idx_can != frames[i].idx_can)
+		{
+			cout << name << ": round trip mismatch at " << i << endl;
+			exit(1);
+		}
+	}
+	cout << setw(12) << left << name << right
+			 << setw(10) << sizeof(can_data_t)
+			 << setw(10) << wire_len[0]
+			 << setw(12) << fixed << setprecision(2) << raw_ns
+			 << setw(12) << encode_ns
+			 << setw(12) << decode_ns << endl;
+}
+
+int	main()
+{
+	cout << setw(12) << left << "type" << right
+			 << setw(10) << "raw B" << setw(10) << "wire B"
+			 << setw(12) << "memcpy ns" << setw(12) << "encode ns" << setw(12) << "decode ns" << endl;
+	bench_type("ssv", SSV_MESSAGE);
+	bench_type("ssrv", SSRV_MESSAGE);
+	bench_type("sse", SSE_MESSAGE);
+	bench_type("ssv_packed", SSV_PACKED_MESSAGE);
+	return 0;
+}
@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cluster_sim.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 14:20:11 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/24 16:05:33 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/cluster_sim.hpp"
+
+#include <algorithm>
+
+// Ticks start at a random phase inside the first period, so nodes do not
+// run in lockstep unless the seed says so
+ClusterSim::ClusterSim(const config_t& config)
+	: config(config), nodes(new sim_node_t[config.nodes_count]()), rng(config.seed),
+		faults(config.nodes_count, config.faults, rng.next()), now_us(0), next_seq(0), stats {}
+{
+	events.reserve(config.nodes_count * (config.tx_frames + 1) * 4);
+	tx_frames.resize(config.tx_frames);
+	for (uint16_t i = 0; i < config.nodes_count; ++i)
+	{
+		nodes[i].shared_data.set_payload_mtu(config.payload_mtu);
+		push_event(rng.below(config.tick_us), EVENT_TICK, i, 0);
+	}
+}
+
+ClusterSim::~ClusterSim()
+{
+	param_data = NULL;
+	delete[] nodes;
+}
+
+void	ClusterSim::select_node(uint16_t node)
+{
+	param_data = &nodes[node].param_data;
+}
+
+bool	ClusterSim::post_ssrv(uint16_t node, uint16_t param_num, int32_t value)
+{
+	select_node(node);
+	return nodes[node].shared_data.add_ssrv_message(param_num, value);
+}
+
+void	ClusterSim::run_until(uint64_t time_us)
+{
+	event_t	event;
+
+	while (!events.empty() && events.front().time_us <= time_us)
+	{
+		std::pop_heap(events.begin(), events.end(), event_after_t());
+		event = events.back();
+		events.pop_back();
+		now_us = event.time_us;
+		++stats.events;
+		if (event.kind == EVENT_TICK)
+			tick_node(event.node);
+		else
+			deliver(event.node, event.slot);
+	}
+	if (time_us > now_us)
+		now_us = time_us;
+}
+
+// Agreement is checked once per tick period of virtual time
+bool	ClusterSim::run_until_converged(uint64_t max_time_us)
+{
+	bool	result = count_diffs() == 0;
+
+	while (!result && now_us < max_time_us)
+	{
+		run_until(std::min(now_us + config.tick_us, max_time_us));
+		result = count_diffs() == 0;
+	}
+	return result;
+}
+
+// Parameters that differ from node 0, summed over the other nodes
+uint32_t	ClusterSim::count_diffs() const
+{
+	uint32_t	result = 0;
+
+	for (uint16_t n = 1; n < config.nodes_count; ++n)
+	{
+		for (uint16_t i = 0; i < P_COUNT; ++i)
+		{
+			result += nodes[n].param_data.get_param_value(i) != nodes[0].param_data.get_param_value(i);
+		}
+	}
+	return result;
+}
+
+void	ClusterSim::push_event(uint64_t time_us, uint8_t kind, uint16_t node, uint32_t slot)
+{
+	events.push_back({ time_us, next_seq, slot, node, kind });
+	++next_seq;
+	std::push_heap(events.begin(), events.end(), event_after_t());
+}
+
+uint32_t	ClusterSim::alloc_slot(const can_data_t& frame)
+{
+	uint32_t	slot;
+
+	if (free_slots.empty())
+	{
+		slot = frames.size();
+		frames.push_back(frame);
+		frame_refs.push_back(1);
+	}
+	else
+	{
+		slot = free_slots.back();
+		free_slots.pop_back();
+		frames[slot] = frame;
+		frame_refs[slot] = 1;
+	}
+	return slot;
+}
+
+void	ClusterSim::release_slot(uint32_t slot)
+{
+	--frame_refs[slot];
+	if (frame_refs[slot] == 0)
+		free_slots.push_back(slot);
+}
+
+void	ClusterSim::tick_node(uint16_t node)
+{
+	size_t	frames_count;
+
+	select_node(node);
+	nodes[node].shared_data.period_counter();
+	frames_count = nodes[node].shared_data.get_messages(tx_frames.data(), config.tx_frames, config.tx_budget);
+	for (size_t i = 0; i < frames_count; ++i)
+	{
+		tx_frames[i].idx_can = node;
+		broadcast(node, tx_frames[i]);
+	}
+	++stats.ticks;
+	push_event(now_us + config.tick_us, EVENT_TICK, node, 0);
+}
+
+// The sender holds one reference on the slot until every receiver has
+// its events, so a frame lost everywhere frees its slot right away
+void	ClusterSim::broadcast(uint16_t from, const can_data_t& frame)
+{
+	uint32_t	slot = alloc_slot(frame);
+	uint64_t	delays_us[FAULT_MAX_COPIES];
+	uint16_t	copies;
+
+	++stats.frames_sent;
+	stats.frames_by_type[frame.message_type <= SSV_PACKED_MESSAGE ? frame.message_type : 0] += 1;
+	stats.wire_bytes += WIRE_HEADER_LEN + frame.data_len;
+	for (uint16_t to = 0; to < config.nodes_count; ++to)
+	{
+		copies = to != from ? faults.route(from, to, now_us, delays_us) : 0;
+		for (uint16_t c = 0; c < copies; ++c)
+		{
+			++frame_refs[slot];
+			push_event(now_us + delays_us[c], EVENT_DELIVER, to, slot);
+		}
+	}
+	release_slot(slot);
+}
+
+void	ClusterSim::deliver(uint16_t node, uint32_t slot)
+{
+	can_data_t	frame = frames[slot];
+
+	release_slot(slot);
+	frame.idx = node;
+	select_node(node);
+	nodes[node].shared_data.handle_messages(frame);
+	++stats.deliveries;
+}
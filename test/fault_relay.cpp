@@ -0,0 +1,228 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fault_relay.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 11:48:20 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/24 11:48:20 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/fault_stage.hpp"
+#include "../hdrs/socket.hpp"
+#include "../hdrs/wire_codec.hpp"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+
+// UDP relay between run_nodes(..., TRANSPORT_UDP_RELAY) nodes: takes every
+// frame from the shared group, runs it through a FaultStage once per
+// receiver and sends the surviving copies, when due, to that receiver's
+// own group port.
+//
+//	fault_relay <first_pid> <nodes_count> [-t latency_ms:jitter_ms] [-l loss]
+//		[-b enter:exit:loss] [-d duplicate] [-r reorder:window_ms]
+//		[-p first:last:start_s:end_s] [-s seed]
+//
+// Partition nodes are PIDs and times count from the relay start.
+
+#define RELAY_BATCH				64
+#define MAX_WAIT_MS				100
+#define STATS_PERIOD_US		5000000
+
+using namespace std;
+
+std::mutex mtx_out;
+
+struct	relay_frame_t
+{
+	uint64_t		due_us;
+	uint64_t		seq;
+	uint16_t		to;
+	can_data_t	frame;
+};
+
+struct	relay_frame_after_t
+{
+	bool	operator()(const relay_frame_t& a, const relay_frame_t& b) const
+	{
+		return a.due_us > b.due_us || (a.due_us == b.due_us && a.seq > b.seq);
+	}
+};
+
+typedef priority_queue<relay_frame_t, vector<relay_frame_t>, relay_frame_after_t>	relay_queue_t;
+
+static uint64_t	now_us()
+{
+	timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Options are all "-x value", values ':'-separated
+static bool	parse_options(int argc, char *argv[], uint16_t first_pid, fault_config_t& config,
+											fault_partition_t& partition, uint64_t& seed)
+{
+	bool		result = argc % 2 == 1;
+	double	a = 0.0;
+	double	b = 0.0;
+	double	c = 0.0;
+	double	d = 0.0;
+
+	for (int i = 3; i + 1 < argc && result; i += 2)
+	{
+		if (!strcmp(argv[i], "-t") && sscanf(argv[i + 1], "%lf:%lf", &a, &b) == 2)
+		{
+			config.latency_us = static_cast<uint32_t>(a * 1000);
+			config.jitter_us = static_cast<uint32_t>(b * 1000);
+		}
+		else if (!strcmp(argv[i], "-l") && sscanf(argv[i + 1], "%lf", &a) == 1)
+			config.loss = a;
+		else if (!strcmp(argv[i], "-b") && sscanf(argv[i + 1], "%lf:%lf:%lf", &a, &b, &c) == 3)
+		{
+			config.burst_enter = a;
+			config.burst_exit = b;
+			config.burst_loss = c;
+		}
+		else if (!strcmp(argv[i], "-d") && sscanf(argv[i + 1], "%lf", &a) == 1)
+			config.duplicate = a;
+		else if (!strcmp(argv[i], "-r") && sscanf(argv[i + 1], "%lf:%lf", &a, &b) == 2)
+		{
+			config.reorder = a;
+			config.reorder_us = static_cast<uint32_t>(b * 1000);
+		}
+		else if (!strcmp(argv[i], "-p") && sscanf(argv[i + 1], "%lf:%lf:%lf:%lf", &a, &b, &c, &d) == 4)
+			partition = { static_cast<uint64_t>(c * 1000000), static_cast<uint64_t>(d * 1000000),
+										static_cast<uint16_t>(a - first_pid), static_cast<uint16_t>(b - first_pid) };
+		else if (!strcmp(argv[i], "-s") && sscanf(argv[i + 1], "%lf", &a) == 1)
+			seed = static_cast<uint64_t>(a);
+		else
+			result = false;
+	}
+	return result;
+}
+
+static void	print_stats(const FaultStage& stage, size_t queued)
+{
+	const FaultStage::stats_t&	stats = stage.get_stats();
+
+	cout << "Offered: " << stats.offered
+			 << ", Passed: " << stats.passed
+			 << ", Lost: " << stats.lost
+			 << " (burst " << stats.burst_lost << ")"
+			 << ", Partitioned: " << stats.partitioned
+			 << ", Duplicated: " << stats.duplicated
+			 << ", Reordered: " << stats.reordered
+			 << ", Queued: " << queued << endl;
+}
+
+static void	route_frames(FaultStage& stage, relay_queue_t& queue, uint64_t& seq,
+													udp_batch_t<wire_frame_t, RELAY_BATCH>& batch, uint16_t received,
+													uint16_t first_pid, uint64_t start_us)
+{
+	can_data_t	frame {};
+	uint64_t		now = now_us();
+	uint64_t		delays_us[FAULT_MAX_COPIES];
+	uint16_t		from;
+	uint16_t		copies;
+
+	for (uint16_t i = 0; i < received; ++i)
+	{
+		// Malformed datagrams and unknown senders go nowhere
+		from = stage.get_nodes_count();
+		if (decode_frame(batch.data[i].bytes, batch.get_length(i), frame))
+			from = frame.idx_can - first_pid;
+		for (uint16_t to = 0; to < stage.get_nodes_count() && from < stage.get_nodes_count(); ++to)
+		{
+			copies = to != from ? stage.route(from, to, now - start_us, delays_us) : 0;
+			for (uint16_t c = 0; c < copies; ++c)
+			{
+				queue.push({ now + delays_us[c], seq, to, frame });
+				++seq;
+			}
+		}
+	}
+}
+
+static void	send_due_frames(relay_queue_t& queue, const vector<udp_data_t>& outputs)
+{
+	wire_frame_t	wire_frame;
+	uint16_t			wire_len;
+	uint64_t			now = now_us();
+
+	while (!queue.empty() && queue.top().due_us <= now)
+	{
+		wire_len = encode_frame(queue.top().frame, wire_frame.bytes);
+		if (wire_len > 0)
+			send_udp(outputs[queue.top().to], wire_frame.bytes, wire_len);
+		queue.pop();
+	}
+}
+
+static void	run_relay(uint16_t first_pid, uint16_t nodes_count, const fault_config_t& config,
+											const fault_partition_t& partition, uint64_t seed)
+{
+	static udp_batch_t<wire_frame_t, RELAY_BATCH>	batch;
+	FaultStage					stage(nodes_count, config, seed);
+	udp_data_t					input = create_receive_socket(MULTICAST_IP, MULTICAST_PORT, true);
+	vector<udp_data_t>	outputs(nodes_count);
+	relay_queue_t				queue;
+	uint64_t						seq = 0;
+	uint64_t						start_us = now_us();
+	uint64_t						stats_us = start_us + STATS_PERIOD_US;
+	uint64_t						wait_ms;
+	pollfd							poll_fd = { input.sock_fd, POLLIN, 0 };
+
+	if (partition.end_us > partition.start_us)
+		stage.add_partition(partition);
+	for (uint16_t i = 0; i < nodes_count; ++i)
+	{
+		outputs[i] = create_sender_socket(MULTICAST_RELAY_IP, MULTICAST_RELAY_PORT + first_pid + i, true);
+	}
+	while (true)
+	{
+		wait_ms = queue.empty() ? MAX_WAIT_MS : (queue.top().due_us - min(queue.top().due_us, now_us()) + 999) / 1000;
+		if (poll(&poll_fd, 1, static_cast<int>(min<uint64_t>(wait_ms, MAX_WAIT_MS))) > 0)
+			route_frames(stage, queue, seq, batch, receive_udp_batch(input, batch), first_pid, start_us);
+		send_due_frames(queue, outputs);
+		if (now_us() >= stats_us)
+		{
+			print_stats(stage, queue.size());
+			stats_us += STATS_PERIOD_US;
+		}
+	}
+}
+
+int	main(int argc, char *argv[])
+{
+	fault_config_t		config {};
+	fault_partition_t	partition {};
+	uint64_t					seed = 1;
+	uint16_t					first_pid = argc > 2 ? static_cast<uint16_t>(atoi(argv[1])) : 0;
+	uint16_t					nodes_count = argc > 2 ? static_cast<uint16_t>(atoi(argv[2])) : 0;
+	int								result = 0;
+
+	if (nodes_count == 0 || !parse_options(argc, argv, first_pid, config, partition, seed))
+	{
+		cerr << "usage: fault_relay <first_pid> <nodes_count> [-t latency_ms:jitter_ms] [-l loss] "
+				 << "[-b enter:exit:loss] [-d duplicate] [-r reorder:window_ms] "
+				 << "[-p first:last:start_s:end_s] [-s seed]" << endl;
+		result = 1;
+	}
+	else
+	{
+		run_relay(first_pid, nodes_count, config, partition, seed);
+	}
+	return result;
+}
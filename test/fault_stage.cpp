@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fault_stage.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 09:37:45 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/24 09:37:45 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/fault_stage.hpp"
+
+FaultStage::FaultStage(uint16_t nodes_count, const fault_config_t& config, uint64_t seed)
+	: nodes_count(nodes_count), config(config), rng(seed), stats {},
+		link_delay_us(static_cast<size_t>(nodes_count) * nodes_count, 0),
+		link_bad(static_cast<size_t>(nodes_count) * nodes_count, 0), partitions_count(0)
+{
+}
+
+bool	FaultStage::set_link_delay(uint16_t from, uint16_t to, uint32_t delay_us)
+{
+	bool	result = from < nodes_count && to < nodes_count;
+
+	if (result)
+		link_delay_us[static_cast<size_t>(from) * nodes_count + to] = delay_us;
+	return result;
+}
+
+bool	FaultStage::add_partition(const fault_partition_t& partition)
+{
+	bool	result = partitions_count < FAULT_MAX_PARTITIONS;
+
+	if (result)
+	{
+		partitions[partitions_count] = partition;
+		++partitions_count;
+	}
+	return result;
+}
+
+bool	FaultStage::is_partitioned(uint16_t from, uint16_t to, uint64_t now_us) const
+{
+	bool	result = false;
+	bool	from_inside;
+	bool	to_inside;
+
+	for (uint16_t i = 0; i < partitions_count && !result; ++i)
+	{
+		from_inside = from >= partitions[i].first && from <= partitions[i].last;
+		to_inside = to >= partitions[i].first && to <= partitions[i].last;
+		result = now_us >= partitions[i].start_us && now_us < partitions[i].end_us && from_inside != to_inside;
+	}
+	return result;
+}
+
+// One Gilbert-Elliott step: move the chain, then draw loss in the new state
+bool	FaultStage::is_lost(uint32_t link)
+{
+	bool	result;
+
+	if (link_bad[link])
+		link_bad[link] = !rng.chance(config.burst_exit);
+	else
+		link_bad[link] = rng.chance(config.burst_enter);
+	result = rng.chance(link_bad[link] ? config.burst_loss : config.loss);
+	stats.burst_lost += result && link_bad[link];
+	return result;
+}
+
+// Fills delays_us[FAULT_MAX_COPIES] with the delivery delay of each copy
+// and returns how many copies get through, 0 if the frame is dropped.
+// A reordered copy is held back up to reorder_us, so frames sent after
+// it may overtake it.
+uint16_t	FaultStage::route(uint16_t from, uint16_t to, uint64_t now_us, uint64_t *delays_us)
+{
+	uint32_t	link = static_cast<uint32_t>(from) * nodes_count + to;
+	uint16_t	copies = 0;
+
+	++stats.offered;
+	if (from >= nodes_count || to >= nodes_count || is_partitioned(from, to, now_us))
+		++stats.partitioned;
+	else if (is_lost(link))
+		++stats.lost;
+	else
+		copies = 1 + rng.chance(config.duplicate);
+	stats.passed += copies > 0;
+	stats.duplicated += copies > 1;
+	for (uint16_t c = 0; c < copies; ++c)
+	{
+		delays_us[c] = config.latency_us + link_delay_us[link]
+			+ (config.jitter_us > 0 ? rng.below(config.jitter_us) : 0);
+		if (config.reorder_us > 0 && rng.chance(config.reorder))
+		{
+			delays_us[c] += rng.below(config.reorder_us);
+			++stats.reordered;
+		}
+	}
+	return copies;
+}
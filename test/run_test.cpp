@@ -6,7 +6,7 @@
 /*   By: Pablo Escobar <sataniv.rider@gmail.com>    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/14 13:55:51 by blackrider        #+#    #+#             */
-/*   Updated: 2025/08/04 00:27:52 by Pablo Escob      ###   ########.fr       */
+/*   Updated: 2025/08/24 12:31:09 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -89,12 +89,35 @@ int	create_proc(int id, input_data_t& in_data)
 	}
 }
 
+// All nodes_count nodes in one child process, on one event-loop thread
+int	create_nodes_proc(int first_id, uint16_t nodes_count, input_data_t& in_data, transport_kind_t transport_kind)
+{
+	int pid = fork();
+
+	if (pid < 0)
+	{
+		cerr << "Fork failed" << endl;
+		return -1;
+	}
+	if (pid == 0) // Child process
+	{
+		run_nodes(first_id, nodes_count, in_data.start_iter_val, in_data.kef, transport_kind);
+		exit(0);
+	}
+	else // Parent process
+	{
+		return pid;
+	}
+}
+
 int	menu_f(vector<int>& pids, input_data_t& in_data)
 {
 	int id = 0;
 	int menu = 0;
+	uint16_t nodes_count = 0;
+	int transport = 0;
 
-	cout << "Enter 0 for exist, 1 for add new process, or 2 for end process: ";
+	cout << "Enter 0 for exist, 1 for add new process, 2 for end process, or 3 for add event loop process: ";
 	cin >> menu;
 	cin.ignore(numeric_limits<streamsize>::max(), '\n');
 	switch (menu)
@@ -117,6 +140,19 @@ int	menu_f(vector<int>& pids, input_data_t& in_data)
 		kill(pids[id], SIGTERM);
 		pids.erase(pids.begin() + id);
 		break;
+	case 3:
+		cout << "Enter the first ID of the nodes: ";
+		cin >> id;
+		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+		cout << "Enter the nodes count: ";
+		cin >> nodes_count;
+		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+		cout << "Enter the transport (0 UDP, 1 shared memory, 2 loopback, 3 UDP through fault_relay): ";
+		cin >> transport;
+		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+		cout << "Adding event loop process with IDs: " << id << ".." << id + nodes_count - 1 << endl;
+		pids.push_back(create_nodes_proc(id, nodes_count, in_data, static_cast<transport_kind_t>(transport)));
+		break;
 	default:
 		cout << "Invalid option. Please try again." << endl;
 		break;
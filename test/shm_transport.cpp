@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shm_transport.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/22 10:25:18 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/23 11:02:37 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/shm_transport.hpp"
+#include "../hdrs/socket.hpp"
+
+#include <climits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Shared (not FUTEX_PRIVATE) futex: waiters live in other processes
+static long	futex(std::atomic<uint32_t> *addr, int op, uint32_t val, const timespec *timeout)
+{
+	return syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), op, val, timeout, NULL, 0);
+}
+
+// Every opener creates or extends the object to the same size, and a
+// zero-filled ring is a valid empty ring, so there is no init race.
+const char	*open_shm_transport(shm_data_t& shm_data, const char *name)
+{
+	int					fd = shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, 0600);
+	struct stat	st {};
+	void				*addr = MAP_FAILED;
+	const char	*error = NULL;
+
+	if (fd < 0)
+		error = "shm_open failed";
+	else if (fstat(fd, &st) < 0 || (st.st_size < static_cast<off_t>(sizeof(shm_ring_t))
+		&& ftruncate(fd, sizeof(shm_ring_t)) < 0))
+		error = "shm ftruncate failed";
+	else
+		addr = mmap(NULL, sizeof(shm_ring_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (fd >= 0)
+		close(fd);
+	if (!error && addr == MAP_FAILED)
+		error = "shm mmap failed";
+	shm_data.ring = error ? NULL : static_cast<shm_ring_t *>(addr);
+	shm_data.cursor = error ? 0 : shm_data.ring->head.load(std::memory_order_acquire);
+	shm_data.lost = 0;
+	return error;
+}
+
+shm_data_t	create_shm_transport(const char *name)
+{
+	shm_data_t	shm_data {};
+	const char	*error = open_shm_transport(shm_data, name);
+
+	if (error)
+		die(error);
+	return shm_data;
+}
+
+void	close_shm_transport(shm_data_t& shm_data)
+{
+	if (shm_data.ring)
+	{
+		munmap(shm_data.ring, sizeof(shm_ring_t));
+		shm_data.ring = NULL;
+	}
+}
+
+void	unlink_shm_transport(const char *name)
+{
+	shm_unlink(name);
+}
+
+void	send_shm(const shm_data_t& shm_data, const can_data_t& frame)
+{
+	shm_ring_t	*ring = shm_data.ring;
+	uint64_t		pos = ring->head.fetch_add(1, std::memory_order_acq_rel);
+	shm_slot_t&	slot = ring->slots[pos & (SHM_RING_SLOTS - 1)];
+
+	slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.frame = frame;
+	slot.seq.store(2 * pos + 2, std::memory_order_release);
+	// seq_cst pairs with wait_shm: either the waiter sees the new head or
+	// we see the waiter
+	ring->wake_seq.fetch_add(1);
+	if (ring->waiters.load() > 0)
+	{
+		futex(&ring->wake_seq, FUTEX_WAKE, INT_MAX, NULL);
+	}
+}
+
+// Seqlock read of the slot at the reader's cursor. A writer that lapped
+// the reader moves the cursor to the oldest frame still in the ring.
+bool	receive_shm(shm_data_t& shm_data, can_data_t& frame)
+{
+	shm_ring_t	*ring = shm_data.ring;
+	uint64_t		ready = 0;
+	uint64_t		seq = 0;
+	uint64_t		head;
+	bool				result = false;
+
+	do
+	{
+		if (seq > ready)
+		{
+			head = ring->head.load(std::memory_order_acquire);
+			shm_data.lost += head - SHM_RING_SLOTS - shm_data.cursor;
+			shm_data.cursor = head - SHM_RING_SLOTS;
+		}
+		ready = 2 * shm_data.cursor + 2;
+		seq = ring->slots[shm_data.cursor & (SHM_RING_SLOTS - 1)].seq.load(std::memory_order_acquire);
+		if (seq == ready)
+		{
+			frame = ring->slots[shm_data.cursor & (SHM_RING_SLOTS - 1)].frame;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			seq = ring->slots[shm_data.cursor & (SHM_RING_SLOTS - 1)].seq.load(std::memory_order_relaxed);
+			result = seq == ready;
+		}
+	} while (seq > ready);
+	if (result)
+	{
+		++shm_data.cursor;
+	}
+	return result;
+}
+
+uint16_t	receive_shm_batch(shm_data_t& shm_data, can_data_t *frames, uint16_t max_frames)
+{
+	uint16_t	received = 0;
+
+	while (received < max_frames && receive_shm(shm_data, frames[received]))
+	{
+		++received;
+	}
+	return received;
+}
+
+static int64_t	monotonic_ms()
+{
+	timespec	ts {};
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Blocks until a frame is readable or timeout_ms passes (-1 waits
+// forever). Returns true when a frame is ready. A wake for a frame this
+// reader already took just sends it back to sleep.
+bool	wait_shm(shm_data_t& shm_data, int timeout_ms)
+{
+	shm_ring_t	*ring = shm_data.ring;
+	int64_t			deadline = monotonic_ms() + timeout_ms;
+	int64_t			left = timeout_ms;
+	timespec		timeout {};
+	uint32_t		wake_seq = ring->wake_seq.load();
+	bool				result = ring->head.load(std::memory_order_acquire) != shm_data.cursor;
+
+	while (!result && left != 0)
+	{
+		timeout.tv_sec = left / 1000;
+		timeout.tv_nsec = (left % 1000) * 1000000L;
+		ring->waiters.fetch_add(1);
+		// Re-check after announcing ourselves, or a send in between is missed
+		if (ring->head.load() == shm_data.cursor)
+		{
+			futex(&ring->wake_seq, FUTEX_WAIT, wake_seq, timeout_ms < 0 ? NULL : &timeout);
+		}
+		ring->waiters.fetch_sub(1);
+		wake_seq = ring->wake_seq.load();
+		result = ring->head.load(std::memory_order_acquire) != shm_data.cursor;
+		if (timeout_ms >= 0)
+		{
+			left = deadline - monotonic_ms();
+			left = left > 0 ? left : 0;
+		}
+	}
+	return result;
+}
@@ -6,7 +6,7 @@
 /*   By: Pablo Escobar <sataniv.rider@gmail.com>    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/27 23:37:35 by Pablo Escob       #+#    #+#             */
-/*   Updated: 2025/07/29 23:56:12 by Pablo Escob      ###   ########.fr       */
+/*   Updated: 2025/08/23 11:02:37 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -32,48 +32,75 @@ void die(const char* message)
   exit(1);
 }
 
-udp_data_t	create_sender_socket(const char* multicast_ip, uint16_t multicast_port)
+const char	*open_sender_socket(udp_data_t& udp_data, const char* multicast_ip, uint16_t multicast_port,
+															bool non_blocking)
 {
-	int	sock_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	int	sock_fd = socket(AF_INET, SOCK_DGRAM | (non_blocking ? SOCK_NONBLOCK : 0), 0);
 	sockaddr_in	remote_addr {};
-	udp_data_t udp_data {};
+	const char	*error = NULL;
 
 	if (sock_fd == INVALID_SOCKET)
-		die("INVALID SENDER SOCKET!!!");
+		error = "INVALID SENDER SOCKET!!!";
 	remote_addr.sin_addr.s_addr = inet_addr(multicast_ip);
 	remote_addr.sin_family = AF_INET;
 	remote_addr.sin_port = htons(multicast_port);
 	udp_data.sock_fd = sock_fd;
 	udp_data.remote_addr = remote_addr;
-	return udp_data;
+	return error;
 }
 
-udp_data_t	create_receive_socket(const char* multicast_ip, uint16_t multicast_port)
+const char	*open_receive_socket(udp_data_t& udp_data, const char* multicast_ip, uint16_t multicast_port,
+															bool non_blocking)
 {
 	int reuse = 1;
-	int	socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	int	socket_fd = socket(AF_INET, SOCK_DGRAM | (non_blocking ? SOCK_NONBLOCK : 0), 0);
+	int buffer_size = 1024 * 1024 * 5; // 5MB buffer
 	struct sockaddr_in	addr {};
 	struct ip_mreq			mreq {};
 	struct sockaddr_in	remote_addr {};
-	udp_data_t udp_data {};
+	const char					*error = NULL;
 
-	if (socket_fd == INVALID_SOCKET)
-		die("INVALID SOCKET");
-	if (setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, (char *)(&reuse), sizeof(reuse)))
-		die("setsockopt(SO_REUSEADDR) failed");
 	addr.sin_family = AF_INET;
 	addr.sin_addr.s_addr = INADDR_ANY;
 	addr.sin_port = htons(multicast_port);
-	if (bind(socket_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
-		die("bind failed");
 	mreq.imr_multiaddr.s_addr = inet_addr(multicast_ip);
 	mreq.imr_interface.s_addr = htonl(INADDR_ANY);
-	if (setsockopt(socket_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char *)&mreq, sizeof(mreq)) < 0)
-		die("setsockopt(IP_ADD_MEMBERSHIP) failed");
-	int buffer_size = 1024 * 1024 * 5; // 5MB buffer
-	if (setsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size)) < 0)
-		die("setsockopt(SO_RCVBUF) failed");
+	if (socket_fd == INVALID_SOCKET)
+		error = "INVALID SOCKET";
+	else if (setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, (char *)(&reuse), sizeof(reuse)))
+		error = "setsockopt(SO_REUSEADDR) failed";
+	else if (bind(socket_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+		error = "bind failed";
+	else if (setsockopt(socket_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char *)&mreq, sizeof(mreq)) < 0)
+		error = "setsockopt(IP_ADD_MEMBERSHIP) failed";
+	else if (setsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size)) < 0)
+		error = "setsockopt(SO_RCVBUF) failed";
+	if (error && socket_fd != INVALID_SOCKET)
+	{
+		close(socket_fd);
+		socket_fd = INVALID_SOCKET;
+	}
 	udp_data.sock_fd = socket_fd;
 	udp_data.remote_addr = remote_addr;
+	return error;
+}
+
+udp_data_t	create_sender_socket(const char* multicast_ip, uint16_t multicast_port, bool non_blocking)
+{
+	udp_data_t	udp_data {};
+	const char	*error = open_sender_socket(udp_data, multicast_ip, multicast_port, non_blocking);
+
+	if (error)
+		die(error);
+	return udp_data;
+}
+
+udp_data_t	create_receive_socket(const char* multicast_ip, uint16_t multicast_port, bool non_blocking)
+{
+	udp_data_t	udp_data {};
+	const char	*error = open_receive_socket(udp_data, multicast_ip, multicast_port, non_blocking);
+
+	if (error)
+		die(error);
 	return udp_data;
 }
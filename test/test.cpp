@@ -6,15 +6,21 @@
 /*   By: Pablo Escobar <sataniv.rider@gmail.com>    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/11 10:11:16 by blackrider        #+#    #+#             */
-/*   Updated: 2025/08/04 00:18:39 by Pablo Escob      ###   ########.fr       */
+/*   Updated: 2025/08/27 09:55:26 by blackrider       ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../hdrs/shared_data.hpp"
+#include "../hdrs/shared_data_actor.hpp"
+#include "../hdrs/param_notifier.hpp"
 #include "../hdrs/client_server_shared_setpoint.hpp"
 #include "../hdrs/test.hpp"
 #include "../hdrs/socket.hpp"
 #include "../hdrs/time_stampt.hpp"
+#include "../hdrs/event_loop.hpp"
+#include "../hdrs/tick_driver.hpp"
+#include "../hdrs/wire_codec.hpp"
+#include "../hdrs/transport.hpp"
 
 #include <iostream>
 #include <thread>
@@ -30,123 +36,173 @@
 
 #define SEND_DURATION		100000
 #define TICK_PERIOD			20 // Period in milliseconds for the tick counter
+#define NOTIFY_CHANNEL	0 // ParamData dirty channel drained by the notifier
+#define RECEIVE_BATCH		64 // Max frames taken per recvmmsg call
+#define TX_FRAMES				4 // Max frames sent per tick by the event-loop nodes
+#define PAYLOAD_MTU			CAN_DATA_MAX_LEN // UDP carries a full CAN FD payload
 
 using namespace std;
 
+// One protocol node for the event-loop runtime. SharedParam reaches
+// ParamData through the global pointer, so select_node() must run before
+// any handler touches the node's SharedData.
+struct	node_t
+{
+	uint16_t								pid;
+	ParamData<P_COUNT>			*param_data;
+	SharedData<P_COUNT>			*shared_data;
+	ParamNotifier<P_COUNT>	*notifier;
+	Transport								*bus;
+	udp_data_t							ssrv_receiver;
+	udp_data_t							test_sender;
+	test_data_t							test_data;
+};
+
+// SSE first, then SSRV twice as often as SSV when all three have work
+static const tx_budget_t	TX_BUDGET = { 0, 4, 2, 1 };
+
 std::mutex mtx_out;
 static uint16_t PID = 0;
 
 ParamData<P_COUNT>	*param_data;
-ParamData<P_COUNT>	*old_param_data;
 SharedData<P_COUNT> *shared_data;
+SharedDataActor<P_COUNT> *shared_data_actor;
+ParamNotifier<P_COUNT> *param_notifier;
 
 uint16_t	get_pid()
 {
 	return PID;
 }
 
-bool	check_param_data(ParamData<P_COUNT> *param_data, ParamData<P_COUNT> *old_param_data)
+void	print_tick_stats(const TickDriver& tick_driver)
 {
-	bool changed = false;
-	for (uint16_t i = 0; i < P_COUNT; ++i)
-	{
-		if (param_data->get_param_value(i) != old_param_data->get_param_value(i))
-		{
-			// mtx_out.lock();
-			// cout << "Param " << param_data->get_param_num(i) << " changed from "
-			// 		 << old_param_data->get_param_value(i) << " to "
-			// 		 << param_data->get_param_value(i) << endl;
-			// print_time_stamp();
-			// mtx_out.unlock();
-			old_param_data->set_param_value(i, param_data->get_param_num(i), param_data->get_param_value(i));
-			changed = true;
-		}
-	}
-	return changed;
+	const TickDriver::stats_t&	stats = tick_driver.get_stats();
+
+	mtx_out.lock();
+	cout << "PID: " << get_pid()
+			 << ", Ticks: " << stats.ticks
+			 << ", Late wakeups: " << stats.late_wakeups
+			 << ", Missed: " << stats.missed
+			 << ", Jitter ns min/mean/max: " << stats.jitter_min_ns
+			 << "/" << tick_driver.get_jitter_mean_ns()
+			 << "/" << stats.jitter_max_ns << endl;
+	mtx_out.unlock();
 }
 
-void	send_ssv(udp_data_t& udp_data, SharedData<P_COUNT> *shared_data, ParamData<P_COUNT> *param_data)
+void	print_protocol_stats(const SharedData<P_COUNT>& shared_data)
 {
-	can_data_t	can_data {};
-	uint16_t		send_ssrv_time = rand() % 50 + 1;
+	shared_data_stats_t	stats;
+
+	shared_data.get_stats(stats);
+	mtx_out.lock();
+	cout << "PID: " << get_pid()
+			 << ", Sent SSV/SSRV/SSE: " << stats.counters[STAT_SSV_SENT]
+			 << "/" << stats.counters[STAT_SSRV_SENT]
+			 << "/" << stats.counters[STAT_SSE_SENT]
+			 << ", Received: " << stats.counters[STAT_SSV_RECEIVED]
+			 << "/" << stats.counters[STAT_SSRV_RECEIVED]
+			 << "/" << stats.counters[STAT_SSE_RECEIVED]
+			 << ", Dropped SSRV/SSE: " << stats.counters[STAT_SSRV_DROPPED]
+			 << "/" << stats.counters[STAT_SSE_DROPPED]
+			 << ", Out of range: " << stats.counters[STAT_OUT_OF_RANGE_SSV] + stats.counters[STAT_OUT_OF_RANGE_SSRV]
+			 << ", Conflicts: " << stats.counters[STAT_ITERATOR_CONFLICTS]
+			 << ", Empty ticks: " << stats.counters[STAT_EMPTY_TICKS]
+			 << "/" << stats.counters[STAT_TICKS] << endl;
+	mtx_out.unlock();
+}
+
+// Protocol thread: the only one touching SharedData, see SharedDataActor
+void	send_ssv(udp_data_t& udp_data,
+							SharedDataActor<P_COUNT> *actor,
+							ParamNotifier<P_COUNT> *notifier)
+{
+	can_data_t		can_data {};
+	wire_frame_t	wire_frame;
+	TickDriver		tick_driver(TICK_PERIOD * 1000);
+	uint16_t			ticks;
+	uint16_t			wire_len;
 
 	can_data.idx_can = get_pid();
-	for (int i = 0; i < SEND_DURATION; ++i)
+	tick_driver.start();
+	for (int i = 0; i < SEND_DURATION; i += ticks)
 	{
-		shared_data->period_counter();
-		if (shared_data->get_messages(can_data))
+		ticks = tick_driver.wait_next();
+		for (uint16_t t = 0; t < ticks; ++t)
 		{
-			send_udp(udp_data, can_data);
+			wire_len = actor->tick(can_data) ? encode_frame(can_data, wire_frame.bytes) : 0;
+			if (wire_len > 0)
+			{
+				send_udp(udp_data, wire_frame.bytes, wire_len);
+			}
 		}
-		this_thread::sleep_for(chrono::milliseconds(TICK_PERIOD));
+		notifier->publish();
 	}
+	print_tick_stats(tick_driver);
+	print_protocol_stats(*shared_data);
+	perf_print_report(cout);
 }
 
-int32_t	*crt_para_arr()
+// Consumer thread: sends only what dispatch() hands over, SharedData
+// (and so the iterator) belongs to the protocol thread
+void	send_test_data(udp_data_t& udp_data, ParamNotifier<P_COUNT> *notifier)
 {
-	int32_t	*param_arr = new int32_t[P_COUNT];
-	for (uint16_t i = 0; i < P_COUNT; ++i)
+	test_data_t test_data {};
+	test_data.pid = get_pid();
+	
+	notifier->subscribe(0, UINT16_MAX, [&](uint16_t idx, uint16_t p_num, uint32_t p_val)
 	{
-		param_arr[i] = param_data->get_param_value(i);
+		test_data.param_num = p_num;
+		test_data.param_idx = idx;
+		test_data.param_val = p_val;
+		send_udp(udp_data, test_data);
+
+		// mtx_out.lock();
+		// cout << "Sender PID: " << test_data.pid
+		// 		 << ", Param Index: " << test_data.param_idx
+		// 		 << ", Param Number: " << test_data.param_num
+		// 		 << ", Param Value: " << test_data.param_val
+		// 		 << ", Iterator: " << test_data.iterator << endl;
+		// print_time_stamp();
+		// mtx_out.unlock();
+	});
+	// Initial values were changed before we subscribed, report them too
+	notifier->dispatch();
+	while (true)
+	{
+		if (notifier->wait(-1))
+		{
+			notifier->dispatch();
+		}
 	}
-	return param_arr;
 }
 
-void	send_test_data(udp_data_t& udp_data,
-										SharedData<P_COUNT> *shared_data,
-										ParamData<P_COUNT> *param_data)
+void	receiver_ssv(udp_data_t& udp_data, SharedDataActor<P_COUNT> *actor)
 {
-	test_data_t test_data {};
-	test_data.pid = get_pid();
-	static ParamData<P_COUNT> *old_param_data = new ParamData<P_COUNT>();
-	
+	static udp_batch_t<wire_frame_t, RECEIVE_BATCH>	batch;
+	static can_data_t	frames[RECEIVE_BATCH];
+	uint16_t	received;
+	uint16_t	frames_count;
+
 	while (true)
 	{
-		for (int i = 0; i < P_COUNT; ++i)
+		received = receive_udp_batch(udp_data, batch);
+		frames_count = 0;
+		// Drop malformed datagrams and our own echoes
+		for (uint16_t i = 0; i < received; ++i)
 		{
-			if (param_data->get_param_value(i) != old_param_data->get_param_value(i))
+			if (decode_frame(batch.data[i].bytes, batch.get_length(i), frames[frames_count])
+				&& frames[frames_count].idx_can != get_pid())
 			{
-				test_data.param_num = param_data->get_param_num(i);
-				test_data.param_idx = i;
-				test_data.iterator = shared_data->get_iterator(i);
-				test_data.param_val = param_data->get_param_value(i);
-				old_param_data->set_param_value(i, test_data.param_num, test_data.param_val);
-				send_udp(udp_data, test_data);
-
-				// mtx_out.lock();
-				// cout << "Sender PID: " << test_data.pid
-				// 		 << ", Param Index: " << test_data.param_idx
-				// 		 << ", Param Number: " << test_data.param_num
-				// 		 << ", Param Value: " << test_data.param_val
-				// 		 << ", Iterator: " << test_data.iterator << endl;
-				// print_time_stamp();
-				// mtx_out.unlock();
+				frames[frames_count].idx = get_pid();
+				++frames_count;
 			}
 		}
-		this_thread::sleep_for(chrono::milliseconds(TICK_PERIOD));
+		actor->post_frames(frames, frames_count);
 	}
 }
 
-void	receiver_ssv(udp_data_t& udp_data,
-									SharedData<P_COUNT> *shared_data,
-									ParamData<P_COUNT> *param_data)
-{
-	socklen_t addr_len = sizeof(udp_data.remote_addr);
-	can_data_t	can_data {};
-
-  while (true)
-  {
-		receive_udp(udp_data, can_data);
-    if (can_data.idx_can != get_pid())
-    {
-			can_data.idx = get_pid();
-      shared_data->handle_messages(can_data);
-    }
-  }
-}
-
 void	receive_ssrv_request(udp_data_t& udp_data,
-													SharedData<P_COUNT> *shared_data,
+													SharedDataActor<P_COUNT> *actor,
 													ParamData<P_COUNT> *param_data)
 {
 	ssrv_data_t ssrv_req_message {};
@@ -162,30 +218,20 @@ void	receive_ssrv_request(udp_data_t& udp_data,
 			// 			<< ", Param Index: " << ssrv_req_message.param_idx
 			// 			<< ", Param Value: " << ssrv_req_message.param_val << endl;
 			// mtx_out.unlock();
-			shared_data->add_ssrv_message(param_data->get_param_num(ssrv_req_message.param_idx), ssrv_req_message.param_val);
+			actor->post_ssrv(param_data->get_param_num(ssrv_req_message.param_idx), ssrv_req_message.param_val);
 		}
 	}
 }
 
-void	crt_trhreads(SharedData<P_COUNT> *shared_data, ParamData<P_COUNT> *param_data, ParamData<P_COUNT> *old_param_data)
+void	crt_trhreads(ParamData<P_COUNT> *param_data)
 {
-	int32_t *param_arr = crt_para_arr();
-
-	thread	check_data_change([&]()
-	{
-		while (true)
-		{
-			this_thread::sleep_for(chrono::milliseconds(TICK_PERIOD));
-			check_param_data(param_data, old_param_data);
-		}
-	});
 	thread	send_test_data_thread([&]()
 	{
 		// mtx_out.lock();
 		// cout << "Sender test data thread started." << endl;
 		// mtx_out.unlock();
 		udp_data_t udp_data_sender = create_sender_socket(MULTICAST_TEST_IP, MULTICAST_TEST_PORT);
-		send_test_data(udp_data_sender, shared_data, param_data);
+		send_test_data(udp_data_sender, param_notifier);
 		close(udp_data_sender.sock_fd);
 	});
 	thread sender_thread([&]()
@@ -194,7 +240,7 @@ void	crt_trhreads(SharedData<P_COUNT> *shared_data, ParamData<P_COUNT> *param_da
 		// cout << "Sender thread started." << endl;
 		// mtx_out.unlock();
 		udp_data_t udp_data_sender = create_sender_socket();
-		send_ssv(udp_data_sender, shared_data, param_data);
+		send_ssv(udp_data_sender, shared_data_actor, param_notifier);
 		close(udp_data_sender.sock_fd);
 		exit(0); // Exit after sending messages
 	});
@@ -204,7 +250,7 @@ void	crt_trhreads(SharedData<P_COUNT> *shared_data, ParamData<P_COUNT> *param_da
 		// cout << "Receiver thread started." << endl;
 		// mtx_out.unlock();
 		udp_data_t udp_data_receiver = create_receive_socket();
-		receiver_ssv(udp_data_receiver, shared_data, param_data);
+		receiver_ssv(udp_data_receiver, shared_data_actor);
 		close(udp_data_receiver.sock_fd);
 	});
 	thread ssrv_receiver_thread([&]()
@@ -213,18 +259,120 @@ void	crt_trhreads(SharedData<P_COUNT> *shared_data, ParamData<P_COUNT> *param_da
 		// cout << "SSRV Receiver thread started." << endl;
 		// mtx_out.unlock();
 		udp_data_t udp_data_ssrv_receiver = create_receive_socket(MULTICAST_SSRV_IP, MULTICAST_SSRV_PORT);
-		receive_ssrv_request(udp_data_ssrv_receiver, shared_data, param_data);
+		receive_ssrv_request(udp_data_ssrv_receiver, shared_data_actor, param_data);
 		close(udp_data_ssrv_receiver.sock_fd);
 	});
 	receiver_thread.join();
 	ssrv_receiver_thread.join();
 	sender_thread.join();
 	send_test_data_thread.join();
-	check_data_change.join();
-	delete[] param_arr;
 }
 
-void	init_param_data(ParamData<P_COUNT> *param_data, ParamData<P_COUNT> *old_param_data, uint16_t step_kef)
+void	select_node(node_t& node)
+{
+	param_data = node.param_data;
+	PID = node.pid;
+}
+
+void	node_receive_ssv(node_t& node)
+{
+	static can_data_t	frames[RECEIVE_BATCH];
+	uint16_t	received;
+
+	select_node(node);
+	do
+	{
+		received = node.bus->receive_batch(frames, RECEIVE_BATCH);
+		for (uint16_t i = 0; i < received; ++i)
+		{
+			if (frames[i].idx_can != node.pid)
+			{
+				frames[i].idx = node.pid;
+				node.shared_data->handle_messages(frames[i]);
+			}
+		}
+	} while (received == RECEIVE_BATCH);
+}
+
+// Backends without a poll fd are drained here, once per tick
+void	node_tick(node_t& node)
+{
+	static can_data_t	frames[TX_FRAMES];
+	uint16_t	frames_count;
+
+	if (node.bus->get_poll_fd() < 0)
+		node_receive_ssv(node);
+	select_node(node);
+	node.shared_data->period_counter();
+	frames_count = node.shared_data->get_messages(frames, TX_FRAMES, TX_BUDGET);
+	for (uint16_t i = 0; i < frames_count; ++i)
+	{
+		frames[i].idx_can = node.pid;
+	}
+	node.bus->send_frames(frames, frames_count);
+	node.notifier->publish();
+}
+
+void	node_receive_ssrv(node_t& node)
+{
+	ssrv_data_t ssrv_req_message {};
+
+	select_node(node);
+	while (receive_udp(node.ssrv_receiver, ssrv_req_message))
+	{
+		if (ssrv_req_message.id == node.pid)
+		{
+			node.shared_data->add_ssrv_message(node.param_data->get_param_num(ssrv_req_message.param_idx),
+																					ssrv_req_message.param_val);
+		}
+	}
+}
+
+void	open_node(EventLoop& loop, node_t& node, transport_kind_t transport_kind, LoopbackBus& loopback_bus)
+{
+	node_t	*p_node = &node;
+
+	node.bus = create_transport(transport_kind, &loopback_bus, node.pid);
+	if (!node.bus)
+		die("Unknown transport");
+	if (!node.bus->is_open())
+		die(node.bus->get_error());
+	node.test_sender = create_sender_socket(MULTICAST_TEST_IP, MULTICAST_TEST_PORT, true);
+	node.ssrv_receiver = create_receive_socket(MULTICAST_SSRV_IP, MULTICAST_SSRV_PORT, true);
+	node.test_data.pid = node.pid;
+	node.notifier->subscribe(0, UINT16_MAX, [p_node](uint16_t idx, uint16_t p_num, uint32_t p_val)
+	{
+		p_node->test_data.param_num = p_num;
+		p_node->test_data.param_idx = idx;
+		p_node->test_data.iterator = p_node->shared_data->get_iterator(idx);
+		p_node->test_data.param_val = p_val;
+		send_udp(p_node->test_sender, p_node->test_data);
+	});
+	if ((node.bus->get_poll_fd() >= 0
+			&& !loop.add_fd(node.bus->get_poll_fd(), [p_node](uint32_t) { node_receive_ssv(*p_node); }))
+		|| !loop.add_fd(node.ssrv_receiver.sock_fd, [p_node](uint32_t) { node_receive_ssrv(*p_node); })
+		|| !loop.add_fd(node.notifier->get_fd(), [p_node](uint32_t)
+			{
+				select_node(*p_node);
+				p_node->notifier->dispatch();
+			}))
+	{
+		die("EventLoop is full");
+	}
+}
+
+void	close_node(EventLoop& loop, node_t& node)
+{
+	if (node.bus->get_poll_fd() >= 0)
+		loop.remove_fd(node.bus->get_poll_fd());
+	loop.remove_fd(node.ssrv_receiver.sock_fd);
+	loop.remove_fd(node.notifier->get_fd());
+	delete node.bus;
+	close(node.test_sender.sock_fd);
+	close(node.ssrv_receiver.sock_fd);
+}
+
+void	init_param_data(ParamData<P_COUNT> *param_data, uint16_t step_kef)
 {
 	int32_t param_value = 0;
 
@@ -232,7 +380,6 @@ void	init_param_data(ParamData<P_COUNT> *param_data, ParamData<P_COUNT> *old_par
 	{
 		param_value = static_cast<int32_t>(std::rand() % 9999 + 2077);
 		param_data->set_param_value(i, i * step_kef, param_value);
-		old_param_data->set_param_value(i, i * step_kef, param_value);
 	}
 }
 
@@ -258,19 +405,87 @@ void	init_shared_data(SharedData<P_COUNT> *shared_data,
 void	run_app(uint16_t pid, uint16_t iterator_start_value, uint16_t param_kef)
 {
 	param_data = new ParamData<P_COUNT>();
-	old_param_data = new ParamData<P_COUNT>();
 	shared_data = new SharedData<P_COUNT>();
+	shared_data_actor = new SharedDataActor<P_COUNT>(shared_data);
+	param_notifier = new ParamNotifier<P_COUNT>(param_data, NOTIFY_CHANNEL);
 
 	PID = pid; // Limit PID to 3 digits for easier reading
 	srand(time(NULL) + get_pid() + getpid()); // Seed random number generator with current time and process ID
-	init_param_data(param_data, old_param_data,  param_kef);
+	init_param_data(param_data, param_kef);
 	init_shared_data(shared_data, param_data, iterator_start_value);
+	shared_data->set_payload_mtu(PAYLOAD_MTU);
 	// print_param_data(param_data);
-	crt_trhreads(shared_data, param_data, old_param_data);
+	crt_trhreads(param_data);
 	delete param_data;
+	delete param_notifier;
+	delete shared_data_actor;
 	delete shared_data;
 }
 
+// Event-loop runtime: nodes_count nodes with consecutive PIDs, their
+// transports, change notifications and one shared tick timerfd, all on
+// the calling thread. Loopback nodes only hear each other.
+void	run_nodes(uint16_t first_pid, uint16_t nodes_count, uint16_t iterator_start_value, uint16_t param_kef,
+									transport_kind_t transport_kind)
+{
+	EventLoop		loop;
+	LoopbackBus	loopback_bus;
+	node_t		*nodes = new node_t[nodes_count]();
+	uint32_t	ticks = 0;
+
+	if (!loop.is_valid())
+		die("EventLoop init failed");
+	srand(time(NULL) + first_pid + getpid());
+	for (uint16_t i = 0; i < nodes_count; ++i)
+	{
+		nodes[i].pid = first_pid + i;
+		nodes[i].param_data = new ParamData<P_COUNT>();
+		nodes[i].shared_data = new SharedData<P_COUNT>();
+		nodes[i].notifier = new ParamNotifier<P_COUNT>(nodes[i].param_data, NOTIFY_CHANNEL);
+		select_node(nodes[i]);
+		init_param_data(nodes[i].param_data, param_kef);
+		init_shared_data(nodes[i].shared_data, nodes[i].param_data, iterator_start_value);
+		nodes[i].shared_data->set_payload_mtu(PAYLOAD_MTU);
+		open_node(loop, nodes[i], transport_kind, loopback_bus);
+	}
+	if (loop.add_timer(TICK_PERIOD, [&](uint64_t expirations)
+		{
+			// Run missed periods too, so protocol time keeps up with the clock
+			for (uint64_t e = 0; e < expirations && ticks < SEND_DURATION; ++e)
+			{
+				for (uint16_t i = 0; i < nodes_count; ++i)
+				{
+					node_tick(nodes[i]);
+				}
+				++ticks;
+			}
+			if (ticks >= SEND_DURATION)
+			{
+				loop.stop();
+			}
+		}) < 0)
+	{
+		die("tick timerfd failed");
+	}
+	// Initial values were changed before the loop started, report them too
+	for (uint16_t i = 0; i < nodes_count; ++i)
+	{
+		select_node(nodes[i]);
+		nodes[i].notifier->dispatch();
+	}
+	loop.run();
+	perf_print_report(cout);
+	for (uint16_t i = 0; i < nodes_count; ++i)
+	{
+		close_node(loop, nodes[i]);
+		delete nodes[i].notifier;
+		delete nodes[i].shared_data;
+		delete nodes[i].param_data;
+	}
+	param_data = NULL;
+	delete[] nodes;
+}
+
 // int main(int argc, char *argv[])
 // {
 // 	uint16_t iterator_start_value;
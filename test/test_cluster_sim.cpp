@@ -0,0 +1,159 @@
+#include "hdrs/cluster_sim.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+#include <chrono>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define TICK_US         20000
+#define SEND_DURATION   100000
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+ClusterSim::config_t make_config(uint16_t nodes_count, uint64_t seed, const fault_config_t& faults)
+{
+    ClusterSim::config_t config {};
+
+    config.nodes_count = nodes_count;
+    config.tick_us = TICK_US;
+    config.seed = seed;
+    config.tx_frames = 4;
+    config.tx_budget = { 0, 4, 2, 1 };
+    config.payload_mtu = CAN_DATA_MAX_LEN;
+    config.faults = faults;
+    return config;
+}
+
+// Same table layout everywhere, different values per node
+void init_nodes(ClusterSim& sim)
+{
+    for (uint16_t n = 0; n < sim.get_nodes_count(); ++n)
+    {
+        sim.select_node(n);
+        sim.get_param_data(n).set_param_max_value(INT32_MAX);
+        for (uint16_t i = 0; i < P_COUNT; ++i)
+        {
+            sim.get_param_data(n).set_param_value(i, i * 3, 1000 + n * 7 + i);
+            sim.get_shared_data(n).set_param_num(i * 3);
+            sim.get_shared_data(n).set_iterator(i, 0);
+        }
+    }
+}
+
+const fault_config_t LOSSY_BUS = { 500, 2000, 30000, 0.2, 0.0, 0.0, 0.0, 0.05, 0.1 };
+
+void test_convergence()
+{
+    print_test_header("Testing Convergence Over A Lossy Bus");
+
+    ClusterSim *sim = new ClusterSim(make_config(10, 7, LOSSY_BUS));
+    const FaultStage::stats_t& stats = sim->get_faults().get_stats();
+
+    init_nodes(*sim);
+    assert(sim->count_diffs() > 0);
+    assert(sim->run_until_converged(1000ull * TICK_US));
+    assert(stats.lost > 0 && stats.duplicated > 0 && stats.reordered > 0);
+    print_success("10 nodes agree after " + std::to_string(sim->get_time_us() / TICK_US) + " ticks, "
+                  + std::to_string(stats.lost) + " lost, " + std::to_string(stats.duplicated) + " duplicated, "
+                  + std::to_string(stats.reordered) + " reordered");
+    assert(sim->post_ssrv(4, 30, 4242));
+    sim->run_ticks(200);
+    for (uint16_t n = 0; n < sim->get_nodes_count(); ++n)
+    {
+        assert(sim->get_param_data(n).get_param_value(10) == 4242);
+    }
+    print_success("An SSRV request from node 4 reaches every node");
+    delete sim;
+}
+
+// Same seed, same run: every counter and every value matches
+void test_reproducible()
+{
+    print_test_header("Testing Reproducibility");
+
+    ClusterSim *a = new ClusterSim(make_config(6, 42, LOSSY_BUS));
+    ClusterSim *b = new ClusterSim(make_config(6, 42, LOSSY_BUS));
+    ClusterSim *c = new ClusterSim(make_config(6, 43, LOSSY_BUS));
+
+    init_nodes(*a);
+    init_nodes(*b);
+    init_nodes(*c);
+    a->post_ssrv(1, 9, 777);
+    b->post_ssrv(1, 9, 777);
+    c->post_ssrv(1, 9, 777);
+    a->run_ticks(500);
+    b->run_ticks(500);
+    c->run_ticks(500);
+    assert(a->get_stats().events == b->get_stats().events);
+    assert(a->get_faults().get_stats().lost == b->get_faults().get_stats().lost);
+    assert(a->get_stats().deliveries == b->get_stats().deliveries);
+    assert(a->get_faults().get_stats().reordered == b->get_faults().get_stats().reordered);
+    for (uint16_t n = 0; n < a->get_nodes_count(); ++n)
+    {
+        for (uint16_t i = 0; i < P_COUNT; ++i)
+        {
+            assert(a->get_param_data(n).get_param_value(i) == b->get_param_data(n).get_param_value(i));
+        }
+    }
+    assert(a->get_faults().get_stats().lost != c->get_faults().get_stats().lost || a->get_stats().deliveries != c->get_stats().deliveries);
+    print_success("Seed 42 replays exactly, seed 43 takes another path");
+    delete a;
+    delete b;
+    delete c;
+}
+
+// A whole SEND_DURATION run of the classic one-frame-per-tick CAN setup,
+// without the 20 ms sleeps
+void test_speed()
+{
+    print_test_header("Testing Simulation Speed");
+
+    ClusterSim::config_t config = make_config(3, 1, { 500, 1000, 0, 0.01, 0.0, 0.0, 0.0, 0.0, 0.0 });
+    ClusterSim *sim;
+    std::chrono::steady_clock::time_point start;
+    double elapsed_ms;
+
+    config.tx_frames = 1;
+    config.payload_mtu = 8;
+    sim = new ClusterSim(config);
+    init_nodes(*sim);
+    start = std::chrono::steady_clock::now();
+    sim->run_ticks(SEND_DURATION);
+    elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    assert(sim->get_stats().ticks >= 3ull * (SEND_DURATION - 1));
+    assert(sim->count_diffs() == 0);
+    print_success(std::to_string(SEND_DURATION) + " ticks of 3 nodes in " + std::to_string(elapsed_ms) + " ms ("
+                  + std::to_string(static_cast<uint64_t>(sim->get_stats().ticks / elapsed_ms)) + " node ticks/ms)");
+    delete sim;
+}
+
+int main()
+{
+    test_convergence();
+    test_reproducible();
+    test_speed();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "hdrs/event_loop.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+void signal_fd(int fd)
+{
+    uint64_t one = 1;
+
+    assert(write(fd, &one, sizeof(one)) == sizeof(one));
+}
+
+void clear_fd(int fd)
+{
+    uint64_t value;
+
+    assert(read(fd, &value, sizeof(value)) == sizeof(value));
+}
+
+void test_add_remove()
+{
+    print_test_header("Testing add_fd And remove_fd");
+
+    EventLoop loop;
+    int fds[EventLoop::MAX_HANDLERS + 1];
+    uint16_t calls = 0;
+    std::shared_ptr<int> token = std::make_shared<int>(0);
+
+    assert(loop.is_valid());
+    for (uint16_t i = 0; i <= EventLoop::MAX_HANDLERS; ++i)
+    {
+        fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    assert(loop.add_fd(fds[0], [&, token](uint32_t)
+    {
+        clear_fd(fds[0]);
+        ++calls;
+    }));
+    assert(!loop.add_fd(fds[0], [](uint32_t) {}));
+    assert(!loop.add_fd(-1, [](uint32_t) {}));
+    assert(loop.run_once(0) == 0);
+    signal_fd(fds[0]);
+    assert(loop.run_once(0) == 1 && calls == 1);
+    print_success("A ready fd runs its handler once, duplicates are refused");
+
+    assert(token.use_count() == 2);
+    assert(loop.remove_fd(fds[0]));
+    assert(token.use_count() == 1);
+    assert(!loop.remove_fd(fds[0]));
+    signal_fd(fds[0]);
+    assert(loop.run_once(0) == 0 && calls == 1);
+    clear_fd(fds[0]);
+    print_success("remove_fd stops the events and drops the handler");
+
+    for (uint16_t i = 0; i < EventLoop::MAX_HANDLERS; ++i)
+    {
+        assert(loop.add_fd(fds[i], [](uint32_t) {}));
+    }
+    assert(!loop.add_fd(fds[EventLoop::MAX_HANDLERS], [](uint32_t) {}));
+    assert(loop.remove_fd(fds[7]));
+    assert(loop.add_fd(fds[EventLoop::MAX_HANDLERS], [](uint32_t) {}));
+    print_success("A full table refuses, a removed slot is reused");
+    for (uint16_t i = 0; i <= EventLoop::MAX_HANDLERS; ++i)
+    {
+        loop.remove_fd(fds[i]);
+        close(fds[i]);
+    }
+}
+
+// A's handler removes itself and C, then adds D, while C is ready in the
+// same batch
+void test_remove_inside_handler()
+{
+    print_test_header("Testing Changes From Inside A Handler");
+
+    EventLoop loop;
+    int a = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int c = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int d = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    std::shared_ptr<int> token = std::make_shared<int>(42);
+    bool is_alive = false;
+    uint16_t c_calls = 0;
+    uint16_t d_calls = 0;
+
+    assert(loop.add_fd(a, [&, token](uint32_t)
+    {
+        clear_fd(a);
+        loop.remove_fd(a);
+        loop.remove_fd(c);
+        assert(loop.add_fd(d, [&](uint32_t)
+        {
+            clear_fd(d);
+            ++d_calls;
+        }));
+        // Still our own closure, not D's handler written over it
+        is_alive = token.use_count() == 2 && *token == 42;
+    }));
+    assert(loop.add_fd(c, [&](uint32_t)
+    {
+        clear_fd(c);
+        ++c_calls;
+    }));
+    signal_fd(a);
+    signal_fd(c);
+    signal_fd(d);
+    loop.run_once(0);
+    assert(is_alive);
+    assert(c_calls == 0);
+    assert(token.use_count() == 1);
+    print_success("The running handler survives, C's pending event is skipped");
+
+    assert(loop.run_once(0) == 1 && d_calls == 1);
+    print_success("D added from the handler runs from the next batch on");
+    loop.remove_fd(d);
+    close(a);
+    close(c);
+    close(d);
+}
+
+void test_timer()
+{
+    print_test_header("Testing Timers");
+
+    EventLoop loop;
+    uint64_t total = 0;
+    uint16_t calls = 0;
+    int timer_fd = loop.add_timer(10, [&](uint64_t expirations)
+    {
+        total += expirations;
+        ++calls;
+    });
+
+    assert(timer_fd >= 0);
+    assert(loop.add_timer(0, [](uint64_t) {}) == -1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(55));
+    assert(loop.run_once(0) == 1);
+    assert(calls == 1 && total >= 4);
+    print_success("A late loop gets " + std::to_string(total) + " expirations in one call");
+
+    while (total < 8)
+    {
+        loop.run_once(100);
+    }
+    assert(loop.remove_timer(timer_fd));
+    calls = 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    assert(loop.run_once(0) == 0 && calls == 0);
+    print_success("remove_timer stops the timer");
+}
+
+void test_stop_from_thread()
+{
+    print_test_header("Testing stop() From Another Thread");
+
+    EventLoop loop;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::thread stopper([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        loop.stop();
+    });
+
+    // Nothing registered: only the wake fd can end epoll_wait
+    loop.run();
+    stopper.join();
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+    print_success("run() returns once another thread calls stop()");
+
+    // A stop() that lands before run() starts is not lost
+    EventLoop early;
+
+    early.stop();
+    early.run();
+    early.run();
+    print_success("stop() before run() makes run() return at once");
+}
+
+int main()
+{
+    test_add_remove();
+    test_remove_inside_handler();
+    test_timer();
+    test_stop_from_thread();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
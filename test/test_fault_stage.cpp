@@ -0,0 +1,175 @@
+#include "hdrs/fault_stage.hpp"
+#include "hdrs/cluster_sim.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define FRAMES      100000
+#define TICK_US     20000
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+bool is_near(double value, double expected, double tolerance)
+{
+    return value > expected - tolerance && value < expected + tolerance;
+}
+
+void test_clean_link()
+{
+    print_test_header("Testing Clean Link");
+
+    FaultStage stage(2, { 1000, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, 1);
+    uint64_t delays_us[FAULT_MAX_COPIES];
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        assert(stage.route(0, 1, i, delays_us) == 1 && delays_us[0] == 1000);
+    }
+    assert(stage.set_link_delay(0, 1, 500));
+    assert(!stage.set_link_delay(0, 2, 500));
+    assert(stage.route(0, 1, 0, delays_us) == 1 && delays_us[0] == 1500);
+    assert(stage.route(1, 0, 0, delays_us) == 1 && delays_us[0] == 1000);
+    print_success("Every frame passes with latency plus the delay of its own link");
+}
+
+void test_rates()
+{
+    print_test_header("Testing Loss, Duplication And Reorder Rates");
+
+    FaultStage stage(2, { 0, 0, 10000, 0.2, 0.0, 0.0, 0.0, 0.1, 0.05 }, 2);
+    const FaultStage::stats_t& stats = stage.get_stats();
+    uint64_t delays_us[FAULT_MAX_COPIES];
+    uint64_t copies = 0;
+
+    for (uint32_t i = 0; i < FRAMES; ++i)
+    {
+        copies += stage.route(0, 1, i, delays_us);
+    }
+    assert(stats.offered == FRAMES && stats.passed + stats.lost == FRAMES);
+    assert(copies == stats.passed + stats.duplicated);
+    assert(is_near(static_cast<double>(stats.lost) / FRAMES, 0.2, 0.01));
+    assert(is_near(static_cast<double>(stats.duplicated) / stats.passed, 0.1, 0.01));
+    assert(is_near(static_cast<double>(stats.reordered) / copies, 0.05, 0.01));
+    print_success(std::to_string(stats.lost) + " lost, " + std::to_string(stats.duplicated) + " duplicated, "
+                  + std::to_string(stats.reordered) + " reordered of " + std::to_string(FRAMES));
+}
+
+// Bursts last 1 / burst_exit frames on average; only the burst loses
+void test_burst_loss()
+{
+    print_test_header("Testing Burst Loss");
+
+    FaultStage stage(2, { 0, 0, 0, 0.0, 0.01, 0.25, 1.0, 0.0, 0.0 }, 3);
+    const FaultStage::stats_t& stats = stage.get_stats();
+    uint64_t delays_us[FAULT_MAX_COPIES];
+    uint64_t bursts = 0;
+    bool was_lost = false;
+    bool lost;
+
+    for (uint32_t i = 0; i < FRAMES; ++i)
+    {
+        lost = stage.route(0, 1, i, delays_us) == 0;
+        bursts += lost && !was_lost;
+        was_lost = lost;
+    }
+    assert(stats.lost == stats.burst_lost && bursts > 0);
+    assert(is_near(static_cast<double>(stats.lost) / bursts, 4.0, 0.5));
+    print_success(std::to_string(bursts) + " bursts, " + std::to_string(static_cast<double>(stats.lost) / bursts)
+                  + " frames long on average");
+}
+
+void test_partition()
+{
+    print_test_header("Testing Partition");
+
+    FaultStage stage(4, { 0, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, 4);
+    uint64_t delays_us[FAULT_MAX_COPIES];
+
+    assert(stage.add_partition({ 100, 200, 2, 3 }));
+    assert(stage.route(0, 2, 99, delays_us) == 1);
+    assert(stage.route(0, 2, 100, delays_us) == 0);
+    assert(stage.route(3, 1, 150, delays_us) == 0);
+    assert(stage.route(2, 3, 150, delays_us) == 1);
+    assert(stage.route(0, 1, 150, delays_us) == 1);
+    assert(stage.route(0, 2, 200, delays_us) == 1);
+    assert(stage.get_stats().partitioned == 2);
+    print_success("Links across the cut drop inside the window only");
+}
+
+// An SSRV change made on the minority side during a partition reaches
+// the majority only after the partition heals
+void test_sim_partition()
+{
+    print_test_header("Testing Partition In ClusterSim");
+
+    ClusterSim::config_t config {};
+    ClusterSim *sim;
+    uint16_t updated = 0;
+
+    config.nodes_count = 6;
+    config.tick_us = TICK_US;
+    config.seed = 5;
+    config.tx_frames = 4;
+    config.tx_budget = { 0, 4, 2, 1 };
+    config.payload_mtu = CAN_DATA_MAX_LEN;
+    config.faults = { 1000, 1000, 0, 0.05, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    sim = new ClusterSim(config);
+    for (uint16_t n = 0; n < config.nodes_count; ++n)
+    {
+        sim->select_node(n);
+        sim->get_param_data(n).set_param_max_value(INT32_MAX);
+        for (uint16_t i = 0; i < P_COUNT; ++i)
+        {
+            sim->get_param_data(n).set_param_value(i, i, 1000 + i);
+            sim->get_shared_data(n).set_param_num(i);
+            sim->get_shared_data(n).set_iterator(i, 0);
+        }
+    }
+    assert(sim->run_until_converged(100ull * TICK_US));
+    sim->get_faults().add_partition({ sim->get_time_us(), sim->get_time_us() + 500ull * TICK_US, 4, 5 });
+    assert(sim->post_ssrv(5, 7, 4242));
+    sim->run_ticks(300);
+    for (uint16_t n = 0; n < config.nodes_count; ++n)
+    {
+        updated += sim->get_param_data(n).get_param_value(7) == 4242;
+    }
+    assert(updated == 2 && sim->count_diffs() > 0);
+    assert(sim->run_until_converged(sim->get_time_us() + 1000ull * TICK_US));
+    assert(sim->get_param_data(0).get_param_value(7) == 4242);
+    print_success("Nodes 4 and 5 keep the change to themselves until the cut heals, then all 6 agree");
+    delete sim;
+}
+
+int main()
+{
+    test_clean_link();
+    test_rates();
+    test_burst_loss();
+    test_partition();
+    test_sim_partition();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "hdrs/shared_data.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+// SharedParam reads the global ParamData: one instance per node
+struct node_t
+{
+    ParamData<P_COUNT> param_data;
+    SharedData<P_COUNT> shared_data;
+};
+
+void init_node(node_t& node, int32_t value_base, int16_t iterator)
+{
+    param_data = &node.param_data;
+    node.param_data.set_param_max_value(INT32_MAX);
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        node.param_data.set_param_value(i, i, value_base + i);
+        node.shared_data.set_param_num(i);
+        node.shared_data.set_iterator(i, iterator);
+    }
+}
+
+void test_mtu()
+{
+    print_test_header("Testing MTU Negotiation");
+
+    node_t *node = new node_t();
+
+    init_node(*node, 0, 0);
+    assert(node->shared_data.get_ssv_per_frame() == 1);
+    node->shared_data.set_payload_mtu(8);
+    assert(node->shared_data.get_ssv_per_frame() == 1);
+    node->shared_data.set_payload_mtu(17);
+    assert(node->shared_data.get_ssv_per_frame() == 2);
+    node->shared_data.set_payload_mtu(CAN_DATA_MAX_LEN);
+    assert(node->shared_data.get_ssv_per_frame() == 7);
+    node->shared_data.set_payload_mtu(1500);
+    assert(node->shared_data.get_ssv_per_frame() == 7);
+    print_success("Classic CAN keeps 1, CAN FD and UDP pack 7");
+    delete node;
+}
+
+// A full table sync takes count / 7 frames
+void test_packed_sync()
+{
+    print_test_header("Testing Packed Sync");
+
+    node_t *sender = new node_t();
+    node_t *receiver = new node_t();
+    can_data_t frames[P_COUNT];
+    size_t n;
+    uint16_t synced = 0;
+
+    init_node(*receiver, 1000, 0);
+    init_node(*sender, 5000, 10);
+    sender->shared_data.set_payload_mtu(CAN_DATA_MAX_LEN);
+    sender->shared_data.period_counter();
+    n = sender->shared_data.get_messages(frames, P_COUNT, { 0, 1, 1, 1 });
+    assert(n == (P_COUNT + 6) / 7);
+    assert(frames[0].message_type == SSV_PACKED_MESSAGE && frames[0].data[0] == 7);
+    param_data = &receiver->param_data;
+    for (size_t i = 0; i < n; ++i)
+    {
+        frames[i].idx = 0;
+        frames[i].idx_can = 1;
+        receiver->shared_data.handle_messages(frames[i]);
+    }
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        synced += receiver->param_data.get_param_value(i) == 5000u + i;
+    }
+    assert(synced == P_COUNT);
+    print_success(std::to_string(P_COUNT) + " params synced with " + std::to_string(n) + " frames");
+    delete sender;
+    delete receiver;
+}
+
+// A count byte larger than the frame is clipped to data_len
+void test_truncated_frame()
+{
+    print_test_header("Testing Truncated Packed Frame");
+
+    node_t *receiver = new node_t();
+    can_data_t frame {};
+    ssv_message_t message { 20, 3, 777 };
+
+    init_node(*receiver, 1000, 0);
+    frame.message_type = SSV_PACKED_MESSAGE;
+    frame.data[0] = 200;
+    memcpy(frame.data + 1, &message, sizeof(message));
+    frame.data_len = 1 + sizeof(message);
+    frame.idx_can = 1;
+    receiver->shared_data.handle_messages(frame);
+    assert(receiver->param_data.get_param_value(3) == 777);
+    assert(receiver->param_data.get_param_value(4) == 1004);
+    print_success("Only the tuple inside data_len is applied");
+    delete receiver;
+}
+
+// Classic messages are read in place and must fit data_len
+void test_short_frames()
+{
+    print_test_header("Testing Short Frames");
+
+    node_t *receiver = new node_t();
+    can_data_t frame {};
+    ssv_message_t message { 20, 3, 777 };
+
+    init_node(*receiver, 1000, 0);
+    frame.message_type = SSV_MESSAGE;
+    memcpy(frame.data, &message, sizeof(message));
+    frame.data_len = sizeof(message) - 1;
+    frame.idx_can = 1;
+    assert(!receiver->shared_data.handle_messages(frame));
+    assert(receiver->param_data.get_param_value(3) == 1003);
+    frame.data_len = UINT16_MAX;
+    assert(receiver->shared_data.handle_messages(frame));
+    assert(receiver->param_data.get_param_value(3) == 777);
+    print_success("Short frame dropped, oversized data_len clipped to the payload");
+    delete receiver;
+}
+
+int main()
+{
+    test_mtu();
+    test_packed_sync();
+    test_truncated_frame();
+    test_short_frames();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
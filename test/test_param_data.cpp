@@ -0,0 +1,241 @@
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+// Three dirty words, the last one partly used
+#define WIDE_COUNT	150
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+template <uint16_t count>
+std::vector<uint16_t> drain(ParamData<count>& data, uint8_t channel)
+{
+    std::vector<uint16_t> result;
+    uint16_t drained = data.drain_dirty(channel, [&](uint16_t idx)
+    {
+        result.push_back(idx);
+    });
+
+    assert(drained == result.size());
+    return result;
+}
+
+// Slot i holds p_num i, both channels start clean
+template <uint16_t count>
+ParamData<count> *create_param_data()
+{
+    ParamData<count> *data = new ParamData<count>();
+
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        data->set_param_value(i, i, 100 + i);
+    }
+    for (uint8_t channel = 0; channel < ParamData<count>::DIRTY_CHANNELS; ++channel)
+    {
+        drain(*data, channel);
+    }
+    return data;
+}
+
+void test_unchanged_write()
+{
+    print_test_header("Testing Unchanged Writes");
+
+    ParamData<WIDE_COUNT> *data = create_param_data<WIDE_COUNT>();
+
+    data->set_param_value(5, 5, 105);
+    assert(!data->is_dirty(0) && !data->is_dirty(1));
+    data->set_param_value(5, 5, 106);
+    assert(data->is_dirty(0) && data->is_dirty(1));
+    print_success("Rewriting the same value leaves the dirty bits clear");
+    delete data;
+}
+
+void test_independent_channels()
+{
+    print_test_header("Testing Independent Channels");
+
+    ParamData<WIDE_COUNT> *data = create_param_data<WIDE_COUNT>();
+    std::vector<uint16_t> drained;
+
+    data->set_param_value(3, 3, 1);
+    drained = drain(*data, 0);
+    assert(drained.size() == 1 && drained[0] == 3);
+    assert(!data->is_dirty(0) && data->is_dirty(1));
+    data->set_param_value(4, 4, 1);
+    drained = drain(*data, 1);
+    assert(drained.size() == 2 && drained[0] == 3 && drained[1] == 4);
+    drained = drain(*data, 0);
+    assert(drained.size() == 1 && drained[0] == 4);
+    assert(!data->is_dirty(0) && !data->is_dirty(1));
+    assert(drain(*data, ParamData<WIDE_COUNT>::DIRTY_CHANNELS).empty());
+    print_success("Each channel drains its own bits only");
+    delete data;
+}
+
+void test_wide_bitmap()
+{
+    print_test_header("Testing Bits Past The First Word");
+
+    ParamData<WIDE_COUNT> *data = create_param_data<WIDE_COUNT>();
+    const uint16_t slots[] = { 0, 63, 64, 127, 128, WIDE_COUNT - 1 };
+    std::vector<uint16_t> drained;
+
+    for (uint16_t idx : slots)
+    {
+        data->set_param_value(idx, idx, 7);
+    }
+    drained = drain(*data, 0);
+    assert(drained.size() == sizeof(slots) / sizeof(slots[0]));
+    for (size_t i = 0; i < drained.size(); ++i)
+    {
+        assert(drained[i] == slots[i]);
+    }
+    data->set_param_value(WIDE_COUNT - 1, WIDE_COUNT - 1, 8);
+    assert(data->is_dirty(0));
+    drained = drain(*data, 0);
+    assert(drained.size() == 1 && drained[0] == WIDE_COUNT - 1);
+    print_success("Word boundaries and the last slot are tracked");
+    delete data;
+}
+
+// A write landing after the drain stays for the next one, nothing is
+// reported twice
+void test_drain_clears_reported()
+{
+    print_test_header("Testing Drain Clears What It Reports");
+
+    ParamData<WIDE_COUNT> *data = create_param_data<WIDE_COUNT>();
+    std::vector<uint16_t> drained;
+    uint16_t late = 0;
+
+    data->set_param_value(10, 10, 1);
+    data->set_param_value(100, 100, 1);
+    data->drain_dirty(0, [&](uint16_t idx)
+    {
+        drained.push_back(idx);
+        if (idx == 10)
+        {
+            // Word 0 is already taken, word 1 not yet
+            data->set_param_value(20, 20, 1);
+            data->set_param_value(110, 110, 1);
+            ++late;
+        }
+    });
+    assert(late == 1);
+    assert(drained.size() == 3 && drained[0] == 10 && drained[1] == 100 && drained[2] == 110);
+    drained = drain(*data, 0);
+    assert(drained.size() == 1 && drained[0] == 20);
+    assert(!data->is_dirty(0));
+    print_success("Reported bits are cleared, bits set meanwhile survive");
+    delete data;
+}
+
+// Value, number and version share one word without spilling into each other
+void test_packed_slot()
+{
+    print_test_header("Testing Packed Slot");
+
+    ParamData<WIDE_COUNT> *data = new ParamData<WIDE_COUNT>();
+
+    assert(data->get_param_version(7) == 0 && data->get_param_value(7) == 0);
+    data->set_param_value(7, UINT16_MAX, UINT32_MAX);
+    assert(data->get_param_num(7) == UINT16_MAX && data->get_param_value(7) == UINT32_MAX);
+    assert(data->get_param_version(7) == 1);
+    data->set_param_value(7, 1, 0);
+    assert(data->get_param_num(7) == 1 && data->get_param_value(7) == 0);
+    assert(data->get_param_version(7) == 2);
+    data->set_param_value(7, 1, 0);
+    assert(data->get_param_version(7) == 3);
+    assert(data->get_param_version(6) == 0 && data->get_param_version(8) == 0);
+    assert(data->get_param_version(WIDE_COUNT) == 0);
+    print_success("Number, value and version read back intact, every write bumps the version");
+    delete data;
+}
+
+void test_version_wrap()
+{
+    print_test_header("Testing Version Wrap");
+
+    ParamData<WIDE_COUNT> *data = new ParamData<WIDE_COUNT>();
+
+    for (uint32_t i = 0; i < UINT16_MAX; ++i)
+    {
+        data->set_param_value(9, 0xABCD, 0x12345678);
+    }
+    assert(data->get_param_version(9) == UINT16_MAX);
+    data->set_param_value(9, 0xABCD, 0x12345678);
+    assert(data->get_param_version(9) == 0);
+    assert(data->get_param_num(9) == 0xABCD && data->get_param_value(9) == 0x12345678);
+    data->set_param_value(9, 0xABCD, 0x12345679);
+    assert(data->get_param_version(9) == 1 && data->get_param_value(9) == 0x12345679);
+    print_success("The version wraps at 16 bits without touching number or value");
+    delete data;
+}
+
+// Two writers on one slot: no increment may get lost
+void test_concurrent_versions()
+{
+    print_test_header("Testing Concurrent Writers");
+
+    const uint32_t writes = 20000;
+    ParamData<WIDE_COUNT> *data = new ParamData<WIDE_COUNT>();
+    std::thread writers[2];
+
+    for (uint16_t w = 0; w < 2; ++w)
+    {
+        writers[w] = std::thread([&, w]()
+        {
+            for (uint32_t i = 0; i < writes; ++i)
+            {
+                data->set_param_value(11, 11, w * writes + i);
+            }
+        });
+    }
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    assert(data->get_param_version(11) == 2 * writes);
+    print_success("Every write of both writers got its own version");
+    delete data;
+}
+
+int main()
+{
+    test_unchanged_write();
+    test_independent_channels();
+    test_wide_bitmap();
+    test_drain_clears_reported();
+    test_packed_slot();
+    test_version_wrap();
+    test_concurrent_versions();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "hdrs/param_idx_map.hpp"
+#include "hdrs/shared_data.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <map>
+#include <mutex>
+#include <cstdlib>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define MAP_COUNT	50
+#define ROUNDS		200
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+void test_insert_erase()
+{
+    print_test_header("Testing Insert And Erase");
+
+    ParamIdxMap<uint8_t, MAP_COUNT> map;
+
+    assert(map.find(7) == MAP_COUNT);
+    assert(map.insert(7, 3) && map.find(7) == 3);
+    assert(map.insert(7, 4) && map.find(7) == 4);
+    assert(map.erase(7) && map.find(7) == MAP_COUNT);
+    assert(!map.erase(7));
+    print_success("Insert, overwrite, erase and a missing erase");
+}
+
+// Random churn against std::map: erasing in the middle of a probe chain
+// must keep every later key findable, and the table never fills up
+void test_churn()
+{
+    print_test_header("Testing Churn");
+
+    ParamIdxMap<uint8_t, MAP_COUNT> map;
+    std::map<uint16_t, uint8_t> reference;
+    uint16_t p_num;
+    uint32_t operations = 0;
+
+    srand(2077);
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        // Few distinct numbers so chains collide and erases hit them
+        p_num = static_cast<uint16_t>((rand() % 200) * 3);
+        if (reference.size() < MAP_COUNT && rand() % 2)
+        {
+            assert(map.insert(p_num, static_cast<uint8_t>(i % MAP_COUNT)));
+            reference[p_num] = static_cast<uint8_t>(i % MAP_COUNT);
+        }
+        else
+        {
+            assert(map.erase(p_num) == (reference.erase(p_num) == 1));
+        }
+        ++operations;
+    }
+    for (uint16_t n = 0; n < 600; ++n)
+    {
+        assert(map.find(n) == (reference.count(n) ? reference[n] : MAP_COUNT));
+    }
+    print_success(std::to_string(operations) + " random inserts and erases match std::map");
+}
+
+// Every slot renumbered ROUNDS times, far more keys than the table holds
+void test_renumbering()
+{
+    print_test_header("Testing Renumbering");
+
+    SharedData<P_COUNT> *shared_data = new SharedData<P_COUNT>();
+    uint16_t p_num;
+
+    for (uint16_t round = 0; round < ROUNDS; ++round)
+    {
+        for (uint16_t i = 0; i < P_COUNT; ++i)
+        {
+            p_num = static_cast<uint16_t>(round * P_COUNT + i);
+            assert(shared_data->set_param_num(p_num));
+            param_data->set_param_value(i, p_num, round);
+        }
+    }
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        p_num = static_cast<uint16_t>((ROUNDS - 1) * P_COUNT + i);
+        assert(shared_data->test_get_idx(p_num) == i);
+        assert(param_data->get_param_idx(p_num) == i);
+        assert(shared_data->test_get_idx(p_num - P_COUNT) == P_COUNT);
+        assert(param_data->get_param_idx(p_num - P_COUNT) == P_COUNT);
+    }
+    print_success(std::to_string(ROUNDS) + " renumberings of every slot, only the current numbers map");
+    delete shared_data;
+}
+
+int main()
+{
+    param_data = new ParamData<P_COUNT>();
+    test_insert_erase();
+    test_churn();
+    test_renumbering();
+    delete param_data;
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
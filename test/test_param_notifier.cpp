@@ -0,0 +1,258 @@
+#include "hdrs/param_notifier.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define CHANNEL	0
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+// Slot i holds p_num i; the initial writes are drained so every test
+// starts from a clean channel
+ParamNotifier<P_COUNT> *create_notifier()
+{
+    ParamNotifier<P_COUNT> *notifier = new ParamNotifier<P_COUNT>(param_data, CHANNEL);
+
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        param_data->set_param_value(i, i, 100 + i);
+    }
+    notifier->dispatch();
+    return notifier;
+}
+
+// Nonblocking read of an eventfd counter, 0 when it is not signaled
+uint64_t read_counter(int fd)
+{
+    uint64_t value = 0;
+
+    if (read(fd, &value, sizeof(value)) != sizeof(value))
+    {
+        value = 0;
+    }
+    return value;
+}
+
+void test_range_filtering()
+{
+    print_test_header("Testing Range Filtering");
+
+    ParamNotifier<P_COUNT> *notifier = create_notifier();
+    std::vector<uint16_t> seen;
+    uint32_t value = 0;
+
+    assert(notifier->subscribe(10, 19, [&](uint16_t idx, uint16_t p_num, uint32_t p_val)
+    {
+        assert(idx == p_num);
+        seen.push_back(p_num);
+        value = p_val;
+    }) >= 0);
+    param_data->set_param_value(10, 10, 500);
+    param_data->set_param_value(19, 19, 501);
+    param_data->set_param_value(9, 9, 502);
+    param_data->set_param_value(40, 40, 503);
+    notifier->publish();
+    assert(notifier->dispatch() == 4);
+    assert(seen.size() == 2 && seen[0] == 10 && seen[1] == 19 && value == 501);
+    print_success("Only writes inside [first_num, last_num] reach the callback, bounds included");
+
+    seen.clear();
+    param_data->set_param_value(15, 15, 115);
+    notifier->publish();
+    assert(notifier->dispatch() == 0 && seen.empty());
+    print_success("Rewriting an unchanged value notifies nobody");
+    delete notifier;
+}
+
+void test_batch_dispatch()
+{
+    print_test_header("Testing Batch Dispatch");
+
+    ParamNotifier<P_COUNT> *notifier = create_notifier();
+    uint16_t calls = 0;
+
+    notifier->subscribe(0, UINT16_MAX, [&](uint16_t, uint16_t, uint32_t)
+    {
+        ++calls;
+    });
+    for (uint16_t i = 0; i < 5; ++i)
+    {
+        param_data->set_param_value(i * 7, i * 7, 9000 + i);
+        notifier->publish();
+    }
+    // The same slot twice in a batch is reported once
+    param_data->set_param_value(0, 0, 8000);
+    notifier->publish();
+    assert(notifier->wait(0));
+    assert(notifier->dispatch() == 5 && calls == 5);
+    assert(!notifier->wait(0));
+    print_success("One dispatch delivers every change of the batch once");
+    delete notifier;
+}
+
+void test_publish_and_eventfd()
+{
+    print_test_header("Testing Publish And Eventfd Subscriptions");
+
+    ParamNotifier<P_COUNT> *notifier = create_notifier();
+    int id = notifier->subscribe_eventfd(0, 9);
+    int fd = notifier->get_subscription_fd(id);
+
+    assert(id >= 0 && fd >= 0);
+    param_data->set_param_value(3, 3, 1);
+    notifier->publish();
+    param_data->set_param_value(4, 4, 1);
+    notifier->publish();
+    notifier->publish();
+    assert(read_counter(notifier->get_fd()) == 1);
+    assert(read_counter(notifier->get_fd()) == 0);
+    // Still signaled until dispatch: no further writes
+    param_data->set_param_value(5, 5, 1);
+    notifier->publish();
+    assert(read_counter(notifier->get_fd()) == 0);
+    print_success("publish() writes once and not again while signaled");
+
+    assert(notifier->dispatch() == 3);
+    assert(read_counter(fd) == 1);
+    param_data->set_param_value(50, 50, 1);
+    notifier->publish();
+    assert(notifier->dispatch() == 1 && read_counter(fd) == 0);
+    for (uint16_t i = 0; i < 2; ++i)
+    {
+        param_data->set_param_value(6, 6, 10 + i);
+        notifier->publish();
+        assert(notifier->dispatch() == 1);
+    }
+    assert(read_counter(fd) == 2);
+    print_success("The subscription eventfd counts batches touching its range");
+
+    param_data->set_param_value(7, 7, 1);
+    notifier->publish();
+    assert(notifier->wait(0));
+    print_success("dispatch() re-arms publish()");
+    delete notifier;
+}
+
+void test_unsubscribe()
+{
+    print_test_header("Testing Unsubscribe");
+
+    ParamNotifier<P_COUNT> *notifier = create_notifier();
+    uint16_t calls = 0;
+    int id = notifier->subscribe(0, UINT16_MAX, [&](uint16_t, uint16_t, uint32_t)
+    {
+        ++calls;
+    });
+    int fd_id = notifier->subscribe_eventfd(0, UINT16_MAX);
+
+    param_data->set_param_value(1, 1, 1);
+    notifier->publish();
+    notifier->dispatch();
+    assert(calls == 1);
+    notifier->unsubscribe(id);
+    notifier->unsubscribe(fd_id);
+    assert(notifier->get_subscription_fd(fd_id) == -1);
+    param_data->set_param_value(1, 1, 2);
+    notifier->publish();
+    assert(notifier->dispatch() == 1 && calls == 1);
+    print_success("No callbacks after unsubscribe, the eventfd is closed");
+
+    for (uint8_t i = 0; i < ParamNotifier<P_COUNT>::MAX_SUBSCRIPTIONS; ++i)
+    {
+        assert(notifier->subscribe(0, 0, ParamNotifier<P_COUNT>::callback_t()) == i);
+    }
+    assert(notifier->subscribe(0, 0, ParamNotifier<P_COUNT>::callback_t()) == -1);
+    print_success("Freed slots are reused, a full table returns -1");
+    delete notifier;
+}
+
+// Callbacks run outside the subscription lock: one may unsubscribe
+// itself, subscribe another, or wait on a thread that does
+void test_reentrant_callbacks()
+{
+    print_test_header("Testing Reentrant Callbacks");
+
+    ParamNotifier<P_COUNT> *notifier = create_notifier();
+    uint16_t once_calls = 0;
+    uint16_t late_calls = 0;
+    int late_id = -1;
+    int once_id = -1;
+
+    once_id = notifier->subscribe(0, UINT16_MAX, [&](uint16_t, uint16_t, uint32_t)
+    {
+        ++once_calls;
+        if (late_id < 0)
+        {
+            notifier->unsubscribe(once_id);
+            late_id = notifier->subscribe(0, UINT16_MAX, [&](uint16_t, uint16_t, uint32_t)
+            {
+                ++late_calls;
+            });
+        }
+    });
+    param_data->set_param_value(2, 2, 1);
+    param_data->set_param_value(3, 3, 1);
+    notifier->publish();
+    assert(notifier->dispatch() == 2);
+    // The copy taken for this batch still holds the removed callback
+    assert(once_calls == 2 && late_id >= 0 && late_calls == 0);
+    param_data->set_param_value(2, 2, 2);
+    notifier->publish();
+    assert(notifier->dispatch() == 1 && once_calls == 2 && late_calls == 1);
+    print_success("A callback unsubscribes itself and subscribes another without deadlock");
+
+    int thread_id = -1;
+
+    notifier->subscribe(8, 8, [&](uint16_t, uint16_t, uint32_t)
+    {
+        std::thread subscriber([&]()
+        {
+            thread_id = notifier->subscribe_eventfd(8, 8);
+        });
+        subscriber.join();
+    });
+    param_data->set_param_value(8, 8, 1);
+    notifier->publish();
+    assert(notifier->dispatch() == 1 && thread_id >= 0);
+    assert(read_counter(notifier->get_subscription_fd(thread_id)) == 0);
+    print_success("A callback joins a thread that subscribes; the new eventfd waits for the next batch");
+    delete notifier;
+}
+
+int main()
+{
+    param_data = new ParamData<P_COUNT>();
+    test_range_filtering();
+    test_batch_dispatch();
+    test_publish_and_eventfd();
+    test_unsubscribe();
+    test_reentrant_callbacks();
+    delete param_data;
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
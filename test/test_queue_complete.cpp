@@ -19,7 +19,7 @@
 #define DIM     "\033[2m"
 
 // Helper function to print queue state
-template<typename T, uint8_t S>
+template<typename T, uint16_t S>
 void print_queue_state(FSQueue<T, S>& queue, const std::string& label)
 {
     std::cout << CYAN << label << RESET << ": ";
@@ -0,0 +1,148 @@
+#include "hdrs/retransmit_scheduler.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+// Nothing is popped before its due tick
+void test_due_gating()
+{
+    print_test_header("Testing Due Tick Gating");
+
+    RetransmitScheduler<int, 4, uint16_t> scheduler;
+    int item = 0;
+
+    assert(scheduler.push(1, 10) == true);
+    assert(scheduler.pop_due(9, item) == false);
+    assert(scheduler.get_count() == 1);
+    assert(scheduler.pop_due(10, item) == true);
+    assert(item == 1);
+    assert(scheduler.is_empty() == true);
+
+    // Overdue items are still released
+    scheduler.push(2, 3);
+    assert(scheduler.pop_due(50, item) == true && item == 2);
+
+    print_success("Due tick gating test passed");
+}
+
+// Items come out by due tick, then in push order
+void test_ordering()
+{
+    print_test_header("Testing Deadline Ordering");
+
+    RetransmitScheduler<int, 8, uint16_t> scheduler;
+    int item = 0;
+
+    scheduler.push(30, 7);
+    scheduler.push(10, 5);
+    scheduler.push(20, 5);
+    scheduler.push(40, 9);
+    scheduler.push(11, 5);
+
+    int expected[] = { 10, 20, 11, 30, 40 };
+    for (int i = 0; i < 5; ++i)
+    {
+        assert(scheduler.pop_due(100, item) == true);
+        assert(item == expected[i]);
+    }
+    assert(scheduler.pop_due(100, item) == false);
+
+    print_success("Deadline ordering test passed");
+}
+
+// Capacity is respected and freed by pop
+void test_capacity()
+{
+    print_test_header("Testing Capacity");
+
+    RetransmitScheduler<int, 3, uint16_t> scheduler;
+    int item = 0;
+
+    assert(scheduler.push(1, 0) && scheduler.push(2, 0) && scheduler.push(3, 0));
+    assert(scheduler.is_full() == true);
+    assert(scheduler.push(4, 0) == false);
+    scheduler.pop_due(0, item);
+    assert(scheduler.push(4, 0) == true);
+
+    print_success("Capacity test passed");
+}
+
+// Due ticks compare correctly across the tick_t wrap
+void test_wraparound()
+{
+    print_test_header("Testing Tick Wraparound");
+
+    RetransmitScheduler<int, 4, uint8_t> scheduler;
+    uint8_t due = 0;
+    int item = 0;
+
+    scheduler.push(2, 3);       // after the wrap
+    scheduler.push(1, 250);     // before the wrap
+    assert(scheduler.peek_due(due) == true && due == 250);
+    assert(scheduler.pop_due(251, item) == true && item == 1);
+    assert(scheduler.pop_due(255, item) == false);
+    assert(scheduler.pop_due(3, item) == true && item == 2);
+
+    print_success("Tick wraparound test passed");
+}
+
+// Fixed period retransmits keep exact spacing regardless of queue depth
+void test_retransmit_period()
+{
+    print_test_header("Testing Retransmit Period");
+
+    RetransmitScheduler<int, 16, uint16_t> scheduler;
+    int item = 0;
+    int sent_at[3] = { -1, -1, -1 };
+    int attempts = 0;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        scheduler.push(100 + i, 0);
+    }
+    scheduler.push(0, 0);
+    for (uint16_t tick = 0; tick < 40 && attempts < 3; ++tick)
+    {
+        if (scheduler.pop_due(tick, item) && item == 0)
+        {
+            sent_at[attempts++] = tick;
+            scheduler.push(0, tick + 2);
+        }
+    }
+    assert(attempts == 3);
+    assert(sent_at[1] - sent_at[0] == 2);
+    assert(sent_at[2] - sent_at[1] == 2);
+
+    print_success("Retransmit period test passed");
+}
+
+int main()
+{
+    std::cout << BOLD << BLUE << "=== RetransmitScheduler UNIT TEST SUITE ===" << RESET << std::endl;
+
+    test_due_gating();
+    test_ordering();
+    test_capacity();
+    test_wraparound();
+    test_retransmit_period();
+
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include "hdrs/ring_queue.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define THREAD_ITEMS 200000
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+// FIFO order, capacity rounding and wraparound, same for every policy
+template <queue_policy_t policy>
+void test_basic(const std::string& name)
+{
+    print_test_header("Testing Basic FIFO (" + name + ")");
+
+    RingQueue<int, 5, policy> queue;
+    int item = 0;
+
+    assert((RingQueue<int, 5, policy>::CAPACITY == 8));
+    assert(queue.is_empty() == true);
+    assert(queue.pop(item) == false);
+    for (int i = 0; i < 8; ++i)
+    {
+        assert(queue.push(i) == true);
+    }
+    assert(queue.is_full() == true);
+    assert(queue.push(8) == false);
+    for (int round = 0; round < 100; ++round)
+    {
+        assert(queue.pop(item) == true);
+        assert(item == round);
+        assert(queue.push(round + 8) == true);
+    }
+    assert(queue.get_count() == 8);
+
+    print_success("Basic FIFO test passed (" + name + ")");
+}
+
+// One producer, one consumer: every item arrives once and in order
+template <queue_policy_t policy>
+void test_single_producer(const std::string& name)
+{
+    print_test_header("Testing Producer/Consumer (" + name + ")");
+
+    RingQueue<uint32_t, 64, policy> queue;
+    std::thread producer([&]()
+    {
+        for (uint32_t i = 0; i < THREAD_ITEMS; ++i)
+        {
+            while (!queue.push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    uint32_t item = 0;
+    while (expected < THREAD_ITEMS)
+    {
+        if (queue.pop(item))
+        {
+            assert(item == expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(queue.is_empty() == true);
+
+    print_success("Producer/consumer test passed (" + name + ")");
+}
+
+// Several producers: per-producer order holds and nothing is lost
+void test_multi_producer()
+{
+    print_test_header("Testing Multiple Producers (MPSC)");
+
+    const uint32_t producers = 4;
+    RingQueue<uint32_t, 64, QUEUE_MPSC> queue;
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> next(producers, 0);
+
+    for (uint32_t p = 0; p < producers; ++p)
+    {
+        threads.push_back(std::thread([&queue, p]()
+        {
+            for (uint32_t i = 0; i < THREAD_ITEMS; ++i)
+            {
+                while (!queue.push(p << 24 | i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    uint32_t received = 0;
+    uint32_t item = 0;
+    while (received < producers * THREAD_ITEMS)
+    {
+        if (queue.pop(item))
+        {
+            assert((item & 0xFFFFFF) == next[item >> 24]);
+            ++next[item >> 24];
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    print_success("Multiple producers test passed (MPSC)");
+}
+
+int main()
+{
+    std::cout << BOLD << BLUE << "=== RingQueue UNIT TEST SUITE ===" << RESET << std::endl;
+
+    test_basic<QUEUE_SINGLE_THREAD>("single thread");
+    test_basic<QUEUE_SPSC>("SPSC");
+    test_basic<QUEUE_MPSC>("MPSC");
+    test_single_producer<QUEUE_SPSC>("SPSC");
+    test_single_producer<QUEUE_MPSC>("MPSC");
+    test_multi_producer();
+
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
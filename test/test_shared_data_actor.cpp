@@ -0,0 +1,255 @@
+#include "hdrs/shared_data_actor.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define FRAME_PRODUCERS			4
+#define FRAMES_PER_PRODUCER	3000
+#define ITERATOR_STRIDE			8
+#define SSRV_PRODUCERS			2
+#define SSRV_PER_PRODUCER		40
+#define SSRV_FIRST_NUM			10
+#define MAX_FRAMES					16
+
+static const tx_budget_t	TX_BUDGET = { 0, 1, 1, 0 };
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+SharedData<P_COUNT> *create_shared_data()
+{
+    SharedData<P_COUNT> *shared_data = new SharedData<P_COUNT>();
+
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        param_data->set_param_value(i, i, 100 + i);
+        shared_data->set_param_num(i);
+        shared_data->set_iterator(i, 0);
+    }
+    return shared_data;
+}
+
+can_data_t make_ssv_frame(uint16_t param_num, int16_t iterator, int32_t param_val)
+{
+    can_data_t frame {};
+    ssv_message_t message { iterator, param_num, param_val };
+
+    frame.message_type = SSV_MESSAGE;
+    frame.data_len = sizeof(message);
+    frame.idx_can = 1;
+    memcpy(frame.data, &message, sizeof(message));
+    return frame;
+}
+
+// Producer p owns parameter p and sends it ever newer iterators and
+// values: a frame applied twice, lost or reordered changes the number
+// of writes to the slot or its final value
+void test_concurrent_producers()
+{
+    print_test_header("Testing Concurrent Producers");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    SharedDataActor<P_COUNT> *actor = new SharedDataActor<P_COUNT>(shared_data);
+    std::atomic<uint16_t> running(FRAME_PRODUCERS + SSRV_PRODUCERS);
+    uint32_t accepted[FRAME_PRODUCERS + SSRV_PRODUCERS] = {};
+    int32_t last_value[FRAME_PRODUCERS] = {};
+    uint16_t versions[FRAME_PRODUCERS];
+    std::vector<std::thread> producers;
+    shared_data_stats_t stats;
+    uint64_t ssrv_rounds = 0;
+    uint32_t posted = FRAME_PRODUCERS * FRAMES_PER_PRODUCER + SSRV_PRODUCERS * SSRV_PER_PRODUCER;
+    uint32_t total_accepted = 0;
+    can_data_t frames[MAX_FRAMES];
+
+    for (uint16_t p = 0; p < FRAME_PRODUCERS; ++p)
+    {
+        versions[p] = param_data->get_param_version(p);
+        producers.emplace_back([&, p]()
+        {
+            for (int32_t k = 1; k <= FRAMES_PER_PRODUCER; ++k)
+            {
+                if (actor->post_frame(make_ssv_frame(p, k * ITERATOR_STRIDE, k)))
+                {
+                    ++accepted[p];
+                    last_value[p] = k;
+                }
+                else
+                {
+                    // Give the protocol thread a chance to drain
+                    std::this_thread::yield();
+                }
+            }
+            running.fetch_sub(1);
+        });
+    }
+    for (uint16_t q = 0; q < SSRV_PRODUCERS; ++q)
+    {
+        producers.emplace_back([&, q]()
+        {
+            for (uint16_t k = 0; k < SSRV_PER_PRODUCER; ++k)
+            {
+                accepted[FRAME_PRODUCERS + q] += actor->post_ssrv(SSRV_FIRST_NUM + q * SSRV_PER_PRODUCER + k, 7000 + k);
+                std::this_thread::yield();
+            }
+            running.fetch_sub(1);
+        });
+    }
+    // Protocol thread: tick while producers run, then long enough for
+    // every queued SSRV to finish its attempts. SSV stays silent: our own
+    // SSVs would move the iterators on and turn late frames into conflicts.
+    while (running.load() > 0)
+    {
+        actor->tick(frames, MAX_FRAMES, TX_BUDGET);
+    }
+    for (uint16_t t = 0; t < 500; ++t)
+    {
+        actor->tick(frames, MAX_FRAMES, TX_BUDGET);
+    }
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    for (uint16_t p = 0; p < FRAME_PRODUCERS; ++p)
+    {
+        assert(static_cast<uint16_t>(param_data->get_param_version(p) - versions[p]) == accepted[p]);
+        assert(last_value[p] == 0 || param_data->get_param_value(p) == static_cast<uint32_t>(last_value[p]));
+    }
+    shared_data->get_stats(stats);
+    assert(stats.counters[STAT_SSV_RECEIVED] == accepted[0] + accepted[1] + accepted[2] + accepted[3]);
+    assert(stats.counters[STAT_ITERATOR_CONFLICTS] == 0);
+    print_success("Every accepted frame was applied once and in order");
+
+    for (uint8_t b = 0; b < STATS_HIST_BUCKETS; ++b)
+    {
+        ssrv_rounds += stats.histograms[HIST_SSRV_ROUND][b];
+    }
+    assert(ssrv_rounds + stats.counters[STAT_SSRV_DROPPED]
+        == accepted[FRAME_PRODUCERS] + accepted[FRAME_PRODUCERS + 1]);
+    print_success("Every accepted SSRV request reached SharedData once");
+
+    for (uint16_t i = 0; i < FRAME_PRODUCERS + SSRV_PRODUCERS; ++i)
+    {
+        total_accepted += accepted[i];
+    }
+    assert(actor->get_dropped() == posted - total_accepted);
+    print_success(std::to_string(posted - total_accepted) + " of " + std::to_string(posted)
+        + " posts hit a full ring, all counted as dropped");
+    delete actor;
+    delete shared_data;
+}
+
+// Without a protocol thread the rings fill up; every overflow counts once
+void test_full_rings()
+{
+    print_test_header("Testing Full Rings");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    SharedDataActor<P_COUNT> *actor = new SharedDataActor<P_COUNT>(shared_data);
+    can_data_t frames[5];
+    uint32_t frames_ring = 0;
+    uint32_t ssrv_ring = 0;
+
+    while (actor->post_frame(make_ssv_frame(0, 8, 1)))
+    {
+        ++frames_ring;
+    }
+    assert(frames_ring > 0 && actor->get_dropped() == 1);
+    for (uint16_t i = 0; i < 5; ++i)
+    {
+        frames[i] = make_ssv_frame(1, 8, 1);
+    }
+    assert(actor->post_frames(frames, 5) == 0 && actor->get_dropped() == 6);
+    while (actor->post_ssrv(SSRV_FIRST_NUM, 1))
+    {
+        ++ssrv_ring;
+    }
+    assert(ssrv_ring > 0 && actor->get_dropped() == 7);
+    print_success("Overflowing post_frame, post_frames and post_ssrv are all counted");
+
+    assert(actor->drain_inbound() == frames_ring + ssrv_ring);
+    assert(actor->drain_inbound() == 0);
+    assert(actor->post_frames(frames, 5) == 5 && actor->get_dropped() == 7);
+    print_success("drain_inbound() empties both rings and frees room again");
+    delete actor;
+    delete shared_data;
+}
+
+// A poster that never stops must not keep drain_inbound() looping: each
+// call handles at most one ring's worth of each kind
+void test_flood_bound()
+{
+    print_test_header("Testing Drain Bound Under Flood");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    SharedDataActor<P_COUNT> *actor = new SharedDataActor<P_COUNT>(shared_data);
+    std::atomic<bool> stop(false);
+    uint32_t rings = 0;
+    uint32_t handled;
+
+    while (actor->post_frame(make_ssv_frame(0, 8, 1)))
+    {
+        ++rings;
+    }
+    while (actor->post_ssrv(SSRV_FIRST_NUM, 1))
+    {
+        ++rings;
+    }
+    std::thread poster([&]()
+    {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            actor->post_ssrv(SSRV_FIRST_NUM, 1);
+            actor->post_frame(make_ssv_frame(0, 8, 1));
+        }
+    });
+    for (uint16_t i = 0; i < 200; ++i)
+    {
+        handled = actor->drain_inbound();
+        assert(handled <= rings);
+        std::this_thread::yield();
+    }
+    stop.store(true, std::memory_order_relaxed);
+    poster.join();
+    print_success("Every drain_inbound() stays within the ring capacities");
+    delete actor;
+    delete shared_data;
+}
+
+int main()
+{
+    param_data = new ParamData<P_COUNT>();
+    param_data->set_param_max_value(INT32_MAX);
+    test_concurrent_producers();
+    test_full_rings();
+    test_flood_bound();
+    delete param_data;
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
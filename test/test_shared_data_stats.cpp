@@ -0,0 +1,288 @@
+#include "hdrs/shared_data.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define MAX_FRAMES	256
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+SharedData<P_COUNT> *create_shared_data()
+{
+    SharedData<P_COUNT> *shared_data = new SharedData<P_COUNT>();
+
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        param_data->set_param_value(i, i, 100 + i);
+        shared_data->set_param_num(i);
+        shared_data->set_iterator(i, 0);
+    }
+    shared_data->period_counter();
+    return shared_data;
+}
+
+can_data_t make_ssv_frame(uint16_t param_num, int16_t iterator, int32_t param_val)
+{
+    can_data_t frame {};
+    ssv_message_t message { iterator, param_num, param_val };
+
+    frame.message_type = SSV_MESSAGE;
+    frame.data_len = sizeof(message);
+    frame.idx_can = 1;
+    memcpy(frame.data, &message, sizeof(message));
+    return frame;
+}
+
+uint64_t hist_total(const shared_data_stats_t& stats, uint8_t hist)
+{
+    uint64_t result = 0;
+
+    for (uint8_t b = 0; b < STATS_HIST_BUCKETS; ++b)
+    {
+        result += stats.histograms[hist][b];
+    }
+    return result;
+}
+
+uint64_t frames_sent(const shared_data_stats_t& stats)
+{
+    return stats.counters[STAT_SSV_SENT] + stats.counters[STAT_SSRV_SENT] + stats.counters[STAT_SSE_SENT];
+}
+
+// Holds while only the single-frame get_messages is used
+bool is_tx_consistent(const shared_data_stats_t& stats)
+{
+    return stats.counters[STAT_TICKS] == frames_sent(stats) + stats.counters[STAT_EMPTY_TICKS];
+}
+
+// Every frame one node sends is counted once by the other
+void test_frame_counters()
+{
+    print_test_header("Testing Frame Counters");
+
+    SharedData<P_COUNT> *sender = create_shared_data();
+    SharedData<P_COUNT> *receiver = create_shared_data();
+    shared_data_stats_t tx;
+    shared_data_stats_t rx;
+    can_data_t frames[MAX_FRAMES];
+    can_data_t frame {};
+    size_t n;
+
+    n = sender->get_messages(frames, MAX_FRAMES, { 0, 1, 1, 1 });
+    for (size_t i = 0; i < n; ++i)
+    {
+        receiver->handle_messages(frames[i]);
+    }
+    assert(sender->add_ssrv_message(7, 4242));
+    for (uint16_t t = 0; t < 40; ++t)
+    {
+        sender->period_counter();
+        if (sender->get_messages(frame))
+        {
+            receiver->handle_messages(frame);
+        }
+    }
+    sender->get_stats(tx);
+    receiver->get_stats(rx);
+    assert(tx.counters[STAT_SSV_SENT] == rx.counters[STAT_SSV_RECEIVED]);
+    assert(tx.counters[STAT_SSRV_SENT] == 3 && rx.counters[STAT_SSRV_RECEIVED] == 3);
+    assert(tx.counters[STAT_TICKS] == 41);
+    assert(frames_sent(tx) + tx.counters[STAT_EMPTY_TICKS] == n + 40);
+    assert(tx.counters[STAT_EMPTY_TICKS] > 0);
+    print_success("SSV and SSRV sent match received, ticks add up");
+
+    frame = make_ssv_frame(60000, 0, 1);
+    receiver->handle_messages(frame);
+    frame.data_len = 1;
+    receiver->handle_messages(frame);
+    frame.message_type = 99;
+    receiver->handle_messages(frame);
+    receiver->get_stats(rx);
+    assert(rx.counters[STAT_UNKNOWN_PARAM] == 1);
+    assert(rx.counters[STAT_RX_DROPPED] == 2);
+    print_success("Unknown parameters and malformed frames are counted apart");
+    delete receiver;
+    delete sender;
+}
+
+// Queue overflows and range checks show up instead of vanishing
+void test_drops_and_range()
+{
+    print_test_header("Testing Drops And Out Of Range");
+
+    const uint16_t queue_size = SharedDataTraits<P_COUNT>::QUEUE_SIZE;
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    shared_data_stats_t stats;
+    can_data_t frame {};
+    ssrv_message_t ssrv { 3, 5 };
+    uint16_t accepted = 0;
+
+    for (uint16_t i = 0; i < queue_size + 5; ++i)
+    {
+        accepted += shared_data->add_ssrv_message(i, 9000 + i);
+    }
+    shared_data->get_stats(stats);
+    assert(accepted == queue_size);
+    assert(stats.counters[STAT_SSRV_DROPPED] == 5);
+    print_success("SSRV requests over QUEUE_SIZE count as dropped");
+
+    // Every local value is over the max: each SSV is out of range and
+    // queues an SSE until sse_queue is full
+    param_data->set_param_max_value(0);
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        frame = make_ssv_frame(i, 0, 1);
+        shared_data->handle_messages(frame);
+    }
+    frame.message_type = SSRV_MESSAGE;
+    frame.data_len = sizeof(ssrv);
+    memcpy(frame.data, &ssrv, sizeof(ssrv));
+    shared_data->handle_messages(frame);
+    shared_data->get_stats(stats);
+    assert(stats.counters[STAT_OUT_OF_RANGE_SSV] == P_COUNT);
+    assert(stats.counters[STAT_OUT_OF_RANGE_SSRV] == 1);
+    assert(stats.counters[STAT_SSE_DROPPED] == P_COUNT + 1 - queue_size);
+    param_data->set_param_max_value(INT32_MAX);
+    print_success("Out of range SSV/SSRV and SSE overflow are counted");
+    delete shared_data;
+}
+
+// A different value with a stale iterator is a conflict, an echo is not
+void test_iterator_conflicts()
+{
+    print_test_header("Testing Iterator Conflicts");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    shared_data_stats_t stats;
+    can_data_t frame {};
+
+    shared_data->set_iterator(4, 10);
+    frame = make_ssv_frame(4, 5, 104);
+    shared_data->handle_messages(frame);
+    shared_data->get_stats(stats);
+    assert(stats.counters[STAT_ITERATOR_CONFLICTS] == 0);
+
+    frame = make_ssv_frame(4, 5, 777);
+    shared_data->handle_messages(frame);
+    shared_data->get_stats(stats);
+    assert(stats.counters[STAT_ITERATOR_CONFLICTS] == 1);
+    assert(param_data->get_param_value(4) == 104);
+
+    frame = make_ssv_frame(4, 20, 777);
+    shared_data->handle_messages(frame);
+    shared_data->get_stats(stats);
+    assert(stats.counters[STAT_ITERATOR_CONFLICTS] == 1);
+    assert(param_data->get_param_value(4) == 777);
+    print_success("Only stale iterators carrying another value count");
+    delete shared_data;
+}
+
+// One SSRV: three attempts in the lag histogram, one round
+void test_histograms()
+{
+    print_test_header("Testing Latency Histograms");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    shared_data_stats_t stats;
+    can_data_t frame {};
+
+    assert(StatsBlock::get_bucket(0) == 0 && StatsBlock::get_bucket(1) == 1);
+    assert(StatsBlock::get_bucket(4) == 3 && StatsBlock::get_bucket(7) == 3);
+    assert(StatsBlock::get_bucket(UINT64_MAX) == STATS_HIST_BUCKETS - 1);
+    assert(shared_data->add_ssrv_message(2, 1234));
+    for (uint16_t t = 0; t < 20; ++t)
+    {
+        shared_data->period_counter();
+        shared_data->get_messages(frame);
+    }
+    shared_data->get_stats(stats);
+    assert(hist_total(stats, HIST_SSRV_LAG) == 3);
+    assert(hist_total(stats, HIST_SSRV_ROUND) == 1);
+    assert(stats.histograms[HIST_SSRV_ROUND][0] == 0);
+    assert(hist_total(stats, HIST_SSE_LAG) == 0);
+    print_success("Bucket bounds hold, attempts and rounds are recorded");
+    delete shared_data;
+}
+
+// A monitor never sees a tick whose frame is not counted yet
+void test_snapshot_consistency()
+{
+    print_test_header("Testing Snapshot Consistency");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    std::atomic<bool> is_done(false);
+    std::atomic<uint32_t> snapshots(0);
+    uint32_t ticks = 0;
+    shared_data_stats_t stats;
+    // Keeps ticking until the reader got its share, even on one CPU
+    std::thread writer([&]()
+    {
+        can_data_t frame {};
+
+        while (ticks < 200000 || snapshots.load(std::memory_order_relaxed) < 1000)
+        {
+            if (ticks % 1000 == 0)
+            {
+                shared_data->add_ssrv_message(ticks % P_COUNT, ticks);
+            }
+            shared_data->period_counter();
+            shared_data->get_messages(frame);
+            ++ticks;
+        }
+        is_done.store(true);
+    });
+
+    while (!is_done.load())
+    {
+        shared_data->get_stats(stats);
+        assert(is_tx_consistent(stats));
+        snapshots.fetch_add(1, std::memory_order_relaxed);
+    }
+    writer.join();
+    assert(snapshots.load() >= 1000);
+    shared_data->get_stats(stats);
+    assert(stats.counters[STAT_TICKS] == ticks && is_tx_consistent(stats));
+    print_success(std::to_string(snapshots.load()) + " snapshots taken during " + std::to_string(ticks)
+        + " ticks, all consistent");
+    delete shared_data;
+}
+
+int main()
+{
+    param_data = new ParamData<P_COUNT>();
+    param_data->set_param_max_value(INT32_MAX);
+    test_frame_counters();
+    test_drops_and_range();
+    test_iterator_conflicts();
+    test_histograms();
+    test_snapshot_consistency();
+    delete param_data;
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "hdrs/shm_transport.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define TEST_BUS	"/shared_data_bus_test"
+#define FRAMES		100000
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+can_data_t make_frame(uint32_t i, uint16_t sender)
+{
+    can_data_t frame {};
+
+    frame.message_type = SSV_MESSAGE;
+    frame.idx_can = sender;
+    frame.data_len = sizeof(i);
+    memcpy(frame.data, &i, sizeof(i));
+    return frame;
+}
+
+uint32_t frame_number(const can_data_t& frame)
+{
+    uint32_t i;
+
+    memcpy(&i, frame.data, sizeof(i));
+    return i;
+}
+
+// Two readers each see every frame, in order, their own included
+void test_broadcast()
+{
+    print_test_header("Testing Broadcast");
+
+    shm_data_t writer = create_shm_transport(TEST_BUS);
+    shm_data_t reader_a = create_shm_transport(TEST_BUS);
+    shm_data_t reader_b = create_shm_transport(TEST_BUS);
+    can_data_t frames[16];
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        send_shm(writer, make_frame(i, 1));
+    }
+    assert(receive_shm_batch(reader_a, frames, 16) == 10);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        assert(frame_number(frames[i]) == i);
+    }
+    assert(receive_shm_batch(reader_b, frames, 4) == 4);
+    assert(receive_shm_batch(reader_b, frames, 16) == 6 && frame_number(frames[5]) == 9);
+    assert(receive_shm_batch(writer, frames, 16) == 10);
+    assert(!receive_shm(reader_a, frames[0]));
+    print_success("Every reader gets all 10 frames in order");
+    close_shm_transport(writer);
+    close_shm_transport(reader_a);
+    close_shm_transport(reader_b);
+}
+
+// A reader lapped by the writers skips to the oldest frame still held
+void test_overrun()
+{
+    print_test_header("Testing Overrun");
+
+    shm_data_t writer = create_shm_transport(TEST_BUS);
+    shm_data_t reader = create_shm_transport(TEST_BUS);
+    can_data_t frame;
+
+    for (uint32_t i = 0; i < SHM_RING_SLOTS + 10; ++i)
+    {
+        send_shm(writer, make_frame(i, 1));
+    }
+    assert(receive_shm(reader, frame));
+    assert(frame_number(frame) == 10);
+    assert(reader.lost == 10);
+    print_success("Lost 10 frames, resumed at frame 10");
+    close_shm_transport(writer);
+    close_shm_transport(reader);
+}
+
+// Another process writes; the reader sleeps on the futex between frames
+void test_cross_process()
+{
+    print_test_header("Testing Cross Process");
+
+    shm_data_t reader = create_shm_transport(TEST_BUS);
+    can_data_t frame;
+    uint32_t next = 0;
+    uint32_t received = 0;
+    pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        shm_data_t writer = create_shm_transport(TEST_BUS);
+
+        usleep(50000);
+        for (uint32_t i = 0; i < FRAMES; ++i)
+        {
+            send_shm(writer, make_frame(i, 2));
+            // Keep within the ring: the reader shares the single CPU
+            if (i % (SHM_RING_SLOTS / 2) == 0)
+            {
+                usleep(1000);
+            }
+        }
+        close_shm_transport(writer);
+        _exit(0);
+    }
+    auto start = std::chrono::steady_clock::now();
+    while (next < FRAMES && wait_shm(reader, 2000))
+    {
+        while (receive_shm(reader, frame))
+        {
+            // In order; a gap only where frames were reported lost
+            assert(frame_number(frame) >= next);
+            next = frame_number(frame) + 1;
+            ++received;
+        }
+    }
+    waitpid(pid, NULL, 0);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    assert(next == FRAMES);
+    assert(received + reader.lost == FRAMES);
+    print_success(std::to_string(FRAMES) + " frames across processes in " + std::to_string(elapsed.count())
+        + " ms, lost " + std::to_string(reader.lost));
+    close_shm_transport(reader);
+}
+
+int main()
+{
+    unlink_shm_transport(TEST_BUS);
+    test_broadcast();
+    test_overrun();
+    test_cross_process();
+    unlink_shm_transport(TEST_BUS);
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "hdrs/tick_driver.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <chrono>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define PERIOD_US	2000
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+int64_t now_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Work inside a tick must not stretch the period
+void test_no_drift()
+{
+    print_test_header("Testing No Drift Under Work");
+
+    TickDriver driver(PERIOD_US);
+    uint64_t ticks = 0;
+    int64_t start = now_us();
+
+    driver.start();
+    while (ticks < 100)
+    {
+        ticks += driver.wait_next();
+        std::this_thread::sleep_for(std::chrono::microseconds(PERIOD_US / 2));
+    }
+    int64_t elapsed = now_us() - start;
+    // sleep_for-based ticking would take ~150 periods here
+    assert(elapsed < 125 * PERIOD_US);
+    assert(driver.get_stats().ticks == ticks);
+    print_success("100 ticks with half a period of work each took " + std::to_string(elapsed) + " us");
+}
+
+// A stall of several periods is caught up in one wakeup
+void test_catch_up()
+{
+    print_test_header("Testing Catch Up");
+
+    TickDriver driver(PERIOD_US, true, 8);
+    uint16_t ticks;
+
+    driver.start();
+    assert(driver.wait_next() >= 1);
+    std::this_thread::sleep_for(std::chrono::microseconds(PERIOD_US * 4 + PERIOD_US / 2));
+    ticks = driver.wait_next();
+    assert(ticks >= 4 && ticks <= 8);
+    assert(driver.get_stats().late_wakeups >= 1);
+    assert(driver.get_stats().missed == 0);
+    print_success("Stall of 4.5 periods returned " + std::to_string(ticks) + " ticks");
+}
+
+// Beyond max_catch_up, or without catch up, deadlines are reported missed
+void test_missed()
+{
+    print_test_header("Testing Missed Ticks");
+
+    TickDriver capped(PERIOD_US, true, 2);
+    TickDriver skipping(PERIOD_US, false);
+
+    capped.start();
+    std::this_thread::sleep_for(std::chrono::microseconds(PERIOD_US * 6));
+    assert(capped.wait_next() == 2);
+    assert(capped.get_stats().missed >= 3);
+    print_success("Capped catch up counts the rest as missed");
+
+    skipping.start();
+    std::this_thread::sleep_for(std::chrono::microseconds(PERIOD_US * 6));
+    assert(skipping.wait_next() == 1);
+    assert(skipping.get_stats().missed >= 4);
+    // Schedule jumped forward: the next tick is on time again
+    skipping.reset_stats();
+    assert(skipping.wait_next() == 1);
+    print_success("Without catch up the schedule skips ahead");
+}
+
+void test_jitter_stats()
+{
+    print_test_header("Testing Jitter Stats");
+
+    TickDriver driver(PERIOD_US);
+
+    driver.start();
+    for (int i = 0; i < 20; ++i)
+    {
+        driver.wait_next();
+    }
+    const TickDriver::stats_t& stats = driver.get_stats();
+    assert(stats.jitter_count == 20);
+    assert(stats.jitter_min_ns >= 0);
+    assert(stats.jitter_min_ns <= driver.get_jitter_mean_ns());
+    assert(driver.get_jitter_mean_ns() <= stats.jitter_max_ns);
+    print_success("Jitter min/mean/max: " + std::to_string(stats.jitter_min_ns) + "/"
+        + std::to_string(driver.get_jitter_mean_ns()) + "/" + std::to_string(stats.jitter_max_ns) + " ns");
+}
+
+int main()
+{
+    test_no_drift();
+    test_catch_up();
+    test_missed();
+    test_jitter_stats();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "hdrs/timer_wheel.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define WHEEL_COUNT	16
+#define WHEEL_SLOTS	4
+
+typedef TimerWheel<uint8_t, WHEEL_COUNT, uint32_t, WHEEL_SLOTS>	wheel_t;
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+// Ticks 2, 6 and 10 all hash to bucket 2; only the current lap expires
+void test_laps()
+{
+    print_test_header("Testing Laps");
+
+    wheel_t wheel;
+
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 2);
+    wheel.schedule(3, 6);
+    wheel.advance(2);
+    assert(wheel.pop_expired() == 2);
+    assert(wheel.pop_expired() == WHEEL_COUNT);
+    assert(wheel.is_scheduled(1) && wheel.is_scheduled(3) && !wheel.is_scheduled(2));
+    wheel.advance(6);
+    assert(wheel.pop_expired() == 3);
+    assert(wheel.pop_expired() == WHEEL_COUNT);
+    wheel.advance(10);
+    assert(wheel.pop_expired() == 1);
+    assert(wheel.pop_expired() == WHEEL_COUNT);
+    print_success("Same bucket, three laps, one expiry per lap");
+}
+
+// Expired entries come out in scheduling order, across several ticks
+void test_fifo()
+{
+    print_test_header("Testing FIFO Expiry");
+
+    wheel_t wheel;
+    uint8_t order[] = { 9, 4, 12, 0, 7 };
+
+    for (uint8_t idx : order)
+    {
+        wheel.schedule(idx, 5);
+    }
+    wheel.schedule(15, 3);
+    wheel.advance(3);
+    wheel.advance(4);
+    wheel.advance(5);
+    assert(wheel.pop_expired() == 15);
+    for (uint8_t idx : order)
+    {
+        assert(wheel.pop_expired() == idx);
+        assert(!wheel.is_scheduled(idx));
+    }
+    assert(wheel.pop_expired() == WHEEL_COUNT);
+    print_success("Six entries expire in the order they were scheduled");
+}
+
+// Cancel a pending entry from the middle of a chain, an expired entry
+// and an idle one; rescheduling moves an entry instead of duplicating it
+void test_cancel()
+{
+    print_test_header("Testing Cancel");
+
+    wheel_t wheel;
+
+    wheel.schedule(1, 7);
+    wheel.schedule(2, 7);
+    wheel.schedule(3, 7);
+    wheel.cancel(2);
+    assert(!wheel.is_scheduled(2));
+    wheel.cancel(2);
+    wheel.cancel(WHEEL_COUNT);
+    assert(!wheel.is_scheduled(WHEEL_COUNT));
+    wheel.schedule(3, 11);
+    wheel.advance(7);
+    assert(wheel.pop_expired() == 1);
+    assert(wheel.pop_expired() == WHEEL_COUNT);
+    assert(wheel.is_scheduled(3));
+    wheel.advance(11);
+    wheel.cancel(3);
+    assert(wheel.pop_expired() == WHEEL_COUNT);
+    wheel.schedule(2, 12);
+    wheel.advance(12);
+    assert(wheel.pop_expired() == 2);
+    print_success("Pending, expired and idle cancels leave the lists consistent");
+}
+
+int main()
+{
+    test_laps();
+    test_fifo();
+    test_cancel();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include "hdrs/transport.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define TEST_SHM_BUS_NAME   "/shared_data_bus_transport_test"
+#define NODES_COUNT         200
+#define TX_FRAMES           4
+#define RECEIVE_BATCH       64
+#define MAX_TICKS           2000
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+can_data_t make_frame(uint16_t idx_can, uint8_t value)
+{
+    can_data_t frame {};
+
+    frame.message_type = SSV_MESSAGE;
+    frame.data[0] = value;
+    frame.data_len = sizeof(ssv_message_t);
+    frame.idx_can = idx_can;
+    return frame;
+}
+
+void test_loopback_broadcast()
+{
+    print_test_header("Testing Loopback Broadcast");
+
+    LoopbackBus bus;
+    LoopbackTransport *a = new LoopbackTransport(bus);
+    LoopbackTransport *b = new LoopbackTransport(bus);
+    LoopbackTransport *c = new LoopbackTransport(bus);
+    can_data_t frames[4];
+
+    assert(a->is_open() && bus.get_ports_count() == 3);
+    assert(a->get_poll_fd() < 0);
+    assert(a->send_frame(make_frame(1, 42)));
+    assert(a->receive_batch(frames, 4) == 0);
+    assert(b->receive_batch(frames, 4) == 1 && frames[0].data[0] == 42 && frames[0].idx_can == 1);
+    assert(c->receive_batch(frames, 4) == 1 && frames[0].data[0] == 42);
+    delete b;
+    assert(bus.get_ports_count() == 2);
+    assert(c->send_frame(make_frame(3, 7)));
+    assert(a->receive_batch(frames, 4) == 1 && frames[0].data[0] == 7);
+    print_success("Every other port gets the frame once, the sender none");
+    delete a;
+    delete c;
+}
+
+void test_loopback_overflow()
+{
+    print_test_header("Testing Loopback Overflow");
+
+    LoopbackBus bus;
+    LoopbackTransport *a = new LoopbackTransport(bus);
+    LoopbackTransport *b = new LoopbackTransport(bus);
+    can_data_t frame {};
+    uint16_t received = 0;
+
+    for (uint16_t i = 0; i < LOOPBACK_QUEUE_SIZE + 10; ++i)
+    {
+        a->send_frame(make_frame(1, static_cast<uint8_t>(i)));
+    }
+    assert(b->get_dropped() == 10);
+    while (b->receive_batch(&frame, 1) == 1)
+    {
+        ++received;
+    }
+    assert(received == LOOPBACK_QUEUE_SIZE && frame.data[0] == static_cast<uint8_t>(LOOPBACK_QUEUE_SIZE - 1));
+    print_success("A full inbound queue drops and counts the newest frames");
+    delete a;
+    delete b;
+}
+
+// 1.2.3.4 is not a multicast group, joining it fails
+void test_open_failure()
+{
+    print_test_header("Testing Open Failure");
+
+    UdpTransport udp("1.2.3.4", MULTICAST_PORT);
+    can_data_t frame {};
+
+    assert(!udp.is_open() && udp.get_error() != NULL);
+    assert(!udp.send_frame(make_frame(1, 1)));
+    assert(udp.receive_batch(&frame, 1) == 0);
+    print_success(std::string("Reported instead of exiting: ") + udp.get_error());
+}
+
+void test_shm()
+{
+    print_test_header("Testing Shared Memory Transport");
+
+    unlink_shm_transport(TEST_SHM_BUS_NAME);
+
+    ShmTransport *a = new ShmTransport(TEST_SHM_BUS_NAME);
+    ShmTransport *b = new ShmTransport(TEST_SHM_BUS_NAME);
+    can_data_t frames[4] = { make_frame(1, 5), make_frame(1, 6) };
+
+    assert(a->is_open() && b->is_open());
+    assert(a->send_frames(frames, 2) == 2);
+    assert(b->wait(100));
+    assert(b->receive_batch(frames, 4) == 2 && frames[0].data[0] == 5 && frames[1].data[0] == 6);
+    assert(a->receive_batch(frames, 4) == 2);
+    print_success("Frames reach every reader, the sender included");
+    delete a;
+    delete b;
+    unlink_shm_transport(TEST_SHM_BUS_NAME);
+}
+
+struct node_t
+{
+    ParamData<P_COUNT> param_data;
+    SharedData<P_COUNT> shared_data;
+    LoopbackTransport transport;
+
+    node_t(LoopbackBus& bus) : transport(bus) {}
+};
+
+uint32_t count_diffs(node_t **nodes)
+{
+    uint32_t diffs = 0;
+
+    for (uint16_t n = 1; n < NODES_COUNT; ++n)
+    {
+        for (uint16_t i = 0; i < P_COUNT; ++i)
+        {
+            diffs += nodes[n]->param_data.get_param_value(i) != nodes[0]->param_data.get_param_value(i);
+        }
+    }
+    return diffs;
+}
+
+// The tick of run_nodes() without the event loop: drain, then send
+void tick_node(node_t& node, uint16_t pid)
+{
+    can_data_t frames[RECEIVE_BATCH];
+    uint16_t received;
+
+    param_data = &node.param_data;
+    do
+    {
+        received = node.transport.receive_batch(frames, RECEIVE_BATCH);
+        for (uint16_t i = 0; i < received; ++i)
+        {
+            frames[i].idx = pid;
+            node.shared_data.handle_messages(frames[i]);
+        }
+    } while (received == RECEIVE_BATCH);
+    node.shared_data.period_counter();
+    received = node.shared_data.get_messages(frames, TX_FRAMES, { 0, 4, 2, 1 });
+    for (uint16_t i = 0; i < received; ++i)
+    {
+        frames[i].idx_can = pid;
+    }
+    node.transport.send_frames(frames, received);
+}
+
+void test_loopback_convergence()
+{
+    print_test_header("Testing Loopback Convergence");
+
+    LoopbackBus bus;
+    node_t **nodes = new node_t *[NODES_COUNT];
+    uint64_t dropped = 0;
+    uint16_t ticks = 0;
+
+    for (uint16_t n = 0; n < NODES_COUNT; ++n)
+    {
+        nodes[n] = new node_t(bus);
+        param_data = &nodes[n]->param_data;
+        for (uint16_t i = 0; i < P_COUNT; ++i)
+        {
+            nodes[n]->param_data.set_param_value(i, i * 3, 1000 + n * 7 + i);
+            nodes[n]->shared_data.set_param_num(i * 3);
+            nodes[n]->shared_data.set_iterator(i, 0);
+        }
+        nodes[n]->shared_data.set_payload_mtu(CAN_DATA_MAX_LEN);
+    }
+    assert(count_diffs(nodes) > 0);
+    while (ticks < MAX_TICKS && (ticks == 0 || count_diffs(nodes) > 0))
+    {
+        for (uint16_t n = 0; n < NODES_COUNT; ++n)
+        {
+            tick_node(*nodes[n], n);
+        }
+        ++ticks;
+    }
+    for (uint16_t n = 0; n < NODES_COUNT; ++n)
+    {
+        dropped += nodes[n]->transport.get_dropped();
+    }
+    assert(count_diffs(nodes) == 0);
+    print_success(std::to_string(NODES_COUNT) + " nodes converged in " + std::to_string(ticks)
+                  + " ticks, " + std::to_string(dropped) + " frames dropped");
+    for (uint16_t n = 0; n < NODES_COUNT; ++n)
+    {
+        delete nodes[n];
+    }
+    delete[] nodes;
+}
+
+int main()
+{
+    test_loopback_broadcast();
+    test_loopback_overflow();
+    test_open_failure();
+    test_shm();
+    test_loopback_convergence();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
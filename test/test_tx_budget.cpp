@@ -0,0 +1,150 @@
+#include "hdrs/shared_data.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+#define MAX_FRAMES	256
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+SharedData<P_COUNT> *create_shared_data()
+{
+    SharedData<P_COUNT> *shared_data = new SharedData<P_COUNT>();
+
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        param_data->set_param_value(i, i, 100 + i);
+        shared_data->set_param_num(i);
+        shared_data->set_iterator(i, 0);
+    }
+    shared_data->period_counter();
+    return shared_data;
+}
+
+uint16_t count_type(const can_data_t *frames, size_t n, uint8_t message_type)
+{
+    uint16_t result = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        result += frames[i].message_type == message_type;
+    }
+    return result;
+}
+
+// SSV alone sweeps every parameter at most once per call
+void test_frame_limits()
+{
+    print_test_header("Testing Frame And Byte Limits");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    can_data_t frames[MAX_FRAMES];
+    size_t n;
+
+    n = shared_data->get_messages(frames, 3, { 0, 1, 1, 1 });
+    assert(n == 3 && count_type(frames, n, SSV_MESSAGE) == 3);
+    n = shared_data->get_messages(frames, MAX_FRAMES, { 0, 1, 1, 1 });
+    assert(n == P_COUNT);
+    print_success("max_frames and one SSV sweep per call hold");
+
+    n = shared_data->get_messages(frames, MAX_FRAMES, { 2 * sizeof(ssv_message_t) + 1, 1, 1, 1 });
+    assert(n == 2);
+    print_success("max_bytes stops before the frame that does not fit");
+
+    n = shared_data->get_messages(frames, MAX_FRAMES, { 0, 1, 1, 0 });
+    assert(n == 0);
+    print_success("Zero weight keeps a class silent");
+    delete shared_data;
+}
+
+// Queued SSRVs get twice the SSV share with weights 2:1
+void test_weighted_sharing()
+{
+    print_test_header("Testing Weighted Sharing");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    can_data_t frames[MAX_FRAMES];
+    size_t n;
+
+    for (uint16_t i = 0; i < 10; ++i)
+    {
+        assert(shared_data->add_ssrv_message(i, 5000 + i));
+    }
+    n = shared_data->get_messages(frames, 9, { 0, 1, 2, 1 });
+    assert(n == 9);
+    assert(count_type(frames, n, SSRV_MESSAGE) == 6);
+    assert(count_type(frames, n, SSV_MESSAGE) == 3);
+    print_success("9 frames split 6 SSRV / 3 SSV");
+    delete shared_data;
+}
+
+// A burst of SSEs no longer starves SSV
+void test_sse_burst()
+{
+    print_test_header("Testing SSE Burst");
+
+    SharedData<P_COUNT> *shared_data = create_shared_data();
+    can_data_t frames[MAX_FRAMES];
+    can_data_t frame {};
+    ssv_message_t message {};
+    size_t n;
+
+    // Every local value is over the max: each received SSV raises an SSE
+    param_data->set_param_max_value(0);
+    for (uint16_t i = 0; i < P_COUNT; ++i)
+    {
+        message.param_num = i;
+        frame.message_type = SSV_MESSAGE;
+        frame.data_len = sizeof(message);
+        memcpy(frame.data, &message, sizeof(message));
+        frame.idx_can = 1;
+        shared_data->handle_messages(frame);
+    }
+    n = shared_data->get_messages(frames, 8, { 0, 3, 1, 1 });
+    assert(n == 8);
+    assert(count_type(frames, n, SSE_MESSAGE) == 6);
+    assert(count_type(frames, n, SSV_MESSAGE) == 2);
+
+    // The single-frame API keeps strict SSE priority
+    shared_data->period_counter();
+    assert(shared_data->get_messages(frame) && frame.message_type == SSE_MESSAGE);
+    param_data->set_param_max_value(UINT32_MAX);
+    print_success("SSE 3 : SSV 1 gives 6 SSE / 2 SSV out of 8");
+    delete shared_data;
+}
+
+int main()
+{
+    param_data = new ParamData<P_COUNT>();
+    param_data->set_param_max_value(UINT32_MAX);
+    test_frame_limits();
+    test_weighted_sharing();
+    test_sse_burst();
+    delete param_data;
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "hdrs/wire_codec.hpp"
+#include "hdrs/client_server_shared_setpoint.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <mutex>
+
+// ANSI Color codes for output
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define BLUE    "\033[34m"
+#define BOLD    "\033[1m"
+
+std::mutex mtx_out;
+ParamData<P_COUNT>	*param_data;
+
+uint16_t	get_pid()
+{
+	return 0;
+}
+
+void print_test_header(const std::string& test_name)
+{
+    std::cout << "\n" << BOLD << BLUE << "=== " << test_name << " ===" << RESET << std::endl;
+}
+
+void print_success(const std::string& message)
+{
+    std::cout << GREEN << "✓ " << message << RESET << std::endl;
+}
+
+template <typename message_t>
+can_data_t make_frame(uint8_t message_type, const message_t& message, uint16_t idx_can)
+{
+    can_data_t frame {};
+
+    frame.message_type = message_type;
+    frame.idx_can = idx_can;
+    memcpy(frame.data, &message, sizeof(message));
+    frame.data_len = sizeof(message);
+    return frame;
+}
+
+// Fixed little-endian layout, independent of the host
+void test_layout()
+{
+    print_test_header("Testing Wire Layout");
+
+    const uint8_t expected[] = { SSV_MESSAGE, 0x34, 0x12, 8, 0xfe, 0xff, 0x02, 0x01, 0x0d, 0x0c, 0x0b, 0x0a };
+    ssv_message_t message { -2, 0x0102, 0x0a0b0c0d };
+    can_data_t frame = make_frame(SSV_MESSAGE, message, 0x1234);
+    wire_frame_t wire;
+
+    assert(encode_frame(frame, wire.bytes) == sizeof(expected));
+    assert(memcmp(wire.bytes, expected, sizeof(expected)) == 0);
+    print_success("SSV frame is 12 bytes: header, then iterator, param_num, param_val");
+}
+
+void test_round_trip()
+{
+    print_test_header("Testing Round Trip");
+
+    can_data_t frames[4];
+    can_data_t decoded;
+    wire_frame_t wire;
+    ssv_message_t ssv { 7, 300, -123456 };
+    uint16_t len;
+
+    frames[0] = make_frame(SSV_MESSAGE, ssv, 1);
+    frames[1] = make_frame(SSRV_MESSAGE, ssrv_message_t { 42, 99999 }, 2);
+    frames[2] = make_frame(SSE_MESSAGE, sse_message_t { -3, 513 }, 3);
+    frames[3] = can_data_t {};
+    frames[3].message_type = SSV_PACKED_MESSAGE;
+    frames[3].idx_can = 4;
+    frames[3].data[0] = 7;
+    for (uint8_t i = 0; i < 7; ++i)
+    {
+        ssv.param_num = i;
+        memcpy(frames[3].data + 1 + i * sizeof(ssv), &ssv, sizeof(ssv));
+    }
+    frames[3].data_len = 1 + 7 * sizeof(ssv);
+    for (int i = 0; i < 4; ++i)
+    {
+        decoded = can_data_t {};
+        len = encode_frame(frames[i], wire.bytes);
+        assert(len == WIRE_HEADER_LEN + frames[i].data_len);
+        assert(decode_frame(wire.bytes, len, decoded));
+        assert(decoded.message_type == frames[i].message_type);
+        assert(decoded.idx_can == frames[i].idx_can);
+        assert(decoded.data_len == frames[i].data_len);
+        assert(memcmp(decoded.data, frames[i].data, frames[i].data_len) == 0);
+    }
+    print_success(std::string("SSV, SSRV, SSE and packed SSV survive encode/decode")
+        + (ssv_codec_t::IS_RAW ? " (raw)" : " (field-wise)"));
+}
+
+void test_malformed()
+{
+    print_test_header("Testing Malformed Frames");
+
+    can_data_t frame = make_frame(SSV_MESSAGE, ssv_message_t { 1, 2, 3 }, 1);
+    can_data_t decoded {};
+    wire_frame_t wire;
+    uint16_t len = encode_frame(frame, wire.bytes);
+
+    assert(!decode_frame(wire.bytes, len - 1, decoded));
+    assert(!decode_frame(wire.bytes, 3, decoded));
+    wire.bytes[0] = 99;
+    assert(!decode_frame(wire.bytes, len, decoded));
+    wire.bytes[0] = SSRV_MESSAGE;
+    assert(!decode_frame(wire.bytes, len, decoded));
+    print_success("Short, unknown-type and size-mismatched frames rejected");
+
+    frame.message_type = SSV_PACKED_MESSAGE;
+    frame.data[0] = 2;
+    frame.data_len = 1 + sizeof(ssv_message_t);
+    assert(encode_frame(frame, wire.bytes) == 0);
+    frame.data_len = CAN_DATA_MAX_LEN + 1;
+    assert(encode_frame(frame, wire.bytes) == 0);
+    print_success("Packed count that disagrees with data_len is not encoded");
+}
+
+int main()
+{
+    test_layout();
+    test_round_trip();
+    test_malformed();
+    std::cout << "\n" << BOLD << GREEN << "ALL TESTS PASSED" << RESET << std::endl;
+    return 0;
+}
@@ -0,0 +1,228 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   transport.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: blackrider <blackrider@student.42.fr>      +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 10:14:52 by blackrider        #+#    #+#             */
+/*   Updated: 2025/08/26 17:58:03 by blackrider       ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../hdrs/transport.hpp"
+
+#include <unistd.h>
+
+uint16_t	Transport::send_frames(const can_data_t *frames, uint16_t count)
+{
+	uint16_t	sent = 0;
+
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		sent += send_frame(frames[i]);
+	}
+	return sent;
+}
+
+UdpTransport::UdpTransport(const char *multicast_ip, uint16_t multicast_port)
+	: UdpTransport(multicast_ip, multicast_port, multicast_ip, multicast_port)
+{
+}
+
+UdpTransport::UdpTransport(const char *tx_ip, uint16_t tx_port, const char *rx_ip, uint16_t rx_port)
+	: sender {INVALID_SOCKET, {}}, receiver {INVALID_SOCKET, {}}
+{
+	error = open_sender_socket(sender, tx_ip, tx_port, true);
+	if (!error)
+		error = open_receive_socket(receiver, rx_ip, rx_port, true);
+}
+
+UdpTransport::~UdpTransport()
+{
+	if (sender.sock_fd != INVALID_SOCKET)
+		close(sender.sock_fd);
+	if (receiver.sock_fd != INVALID_SOCKET)
+		close(receiver.sock_fd);
+}
+
+bool	UdpTransport::send_frame(const can_data_t& frame)
+{
+	return send_frames(&frame, 1) == 1;
+}
+
+// Encodes up to UDP_SEND_BATCH frames per sendmmsg. A full socket buffer
+// drops the rest of the batch, like a busy bus; the protocol retransmits.
+uint16_t	UdpTransport::send_frames(const can_data_t *frames, uint16_t count)
+{
+	uint16_t	next = 0;
+	uint16_t	sent = 0;
+	uint16_t	encoded;
+	uint16_t	done;
+	uint16_t	wire_len;
+
+	while (is_open() && next < count)
+	{
+		encoded = 0;
+		while (next < count && encoded < UDP_SEND_BATCH)
+		{
+			wire_len = encode_frame(frames[next], tx_batch.data[encoded].bytes);
+			if (wire_len > 0)
+			{
+				tx_batch.set_length(encoded, wire_len);
+				++encoded;
+			}
+			++next;
+		}
+		done = send_udp_batch(sender, tx_batch, encoded);
+		if (done < encoded && would_block())
+			dropped += encoded - done;
+		else if (done < encoded)
+			errors += encoded - done;
+		sent += done;
+	}
+	return sent;
+}
+
+uint16_t	UdpTransport::receive_batch(can_data_t *frames, uint16_t max_frames)
+{
+	uint16_t	wanted = max_frames < UDP_RECEIVE_BATCH ? max_frames : UDP_RECEIVE_BATCH;
+	uint16_t	decoded = 0;
+	int				received = -1;
+
+	if (is_open() && wanted > 0)
+	{
+		for (uint16_t i = 0; i < wanted; ++i)
+		{
+			rx_batch.set_length(i, sizeof(wire_frame_t));
+			rx_batch.msgs[i].msg_hdr.msg_name = NULL;
+			rx_batch.msgs[i].msg_hdr.msg_namelen = 0;
+		}
+		received = recvmmsg(receiver.sock_fd, rx_batch.msgs, wanted, 0, NULL);
+	}
+	if (received < 0 && is_open() && wanted > 0 && !would_block())
+		++errors;
+	// Malformed datagrams are not frames of ours
+	for (int i = 0; i < received; ++i)
+	{
+		decoded += decode_frame(rx_batch.data[i].bytes, rx_batch.get_length(i), frames[decoded]);
+	}
+	return decoded;
+}
+
+ShmTransport::ShmTransport(const char *name)
+	: shm_data {}
+{
+	error = open_shm_transport(shm_data, name);
+}
+
+ShmTransport::~ShmTransport()
+{
+	close_shm_transport(shm_data);
+}
+
+bool	ShmTransport::send_frame(const can_data_t& frame)
+{
+	if (is_open())
+		send_shm(shm_data, frame);
+	return is_open();
+}
+
+uint16_t	ShmTransport::receive_batch(can_data_t *frames, uint16_t max_frames)
+{
+	uint16_t	received = 0;
+
+	if (is_open())
+	{
+		received = receive_shm_batch(shm_data, frames, max_frames);
+		dropped = shm_data.lost;
+	}
+	return received;
+}
+
+bool	LoopbackBus::attach(LoopbackTransport *port)
+{
+	bool	result = ports_count < LOOPBACK_MAX_PORTS;
+
+	if (result)
+	{
+		ports[ports_count] = port;
+		++ports_count;
+	}
+	return result;
+}
+
+void	LoopbackBus::detach(LoopbackTransport *port)
+{
+	uint16_t	i = 0;
+
+	while (i < ports_count && ports[i] != port)
+		++i;
+	if (i < ports_count)
+	{
+		--ports_count;
+		ports[i] = ports[ports_count];
+	}
+}
+
+void	LoopbackBus::broadcast(const LoopbackTransport *from, const can_data_t& frame)
+{
+	for (uint16_t i = 0; i < ports_count; ++i)
+	{
+		if (ports[i] != from)
+			ports[i]->deliver(frame);
+	}
+}
+
+LoopbackTransport::LoopbackTransport(LoopbackBus& bus)
+	: bus(bus)
+{
+	if (!bus.attach(this))
+		error = "LoopbackBus is full";
+}
+
+LoopbackTransport::~LoopbackTransport()
+{
+	if (is_open())
+		bus.detach(this);
+}
+
+bool	LoopbackTransport::send_frame(const can_data_t& frame)
+{
+	if (is_open())
+		bus.broadcast(this, frame);
+	return is_open();
+}
+
+uint16_t	LoopbackTransport::receive_batch(can_data_t *frames, uint16_t max_frames)
+{
+	uint16_t	received = 0;
+
+	while (received < max_frames && inbound.pop(frames[received]))
+		++received;
+	return received;
+}
+
+void	LoopbackTransport::deliver(const can_data_t& frame)
+{
+	if (!inbound.push(frame))
+		++dropped;
+}
+
+// NULL for an unknown kind or a loopback transport without a bus; check
+// is_open() for everything else. A relayed node listens on its own
+// group port, so fault_relay can treat every link apart.
+Transport	*create_transport(transport_kind_t kind, LoopbackBus *loopback_bus, uint16_t pid)
+{
+	Transport	*result = NULL;
+
+	if (kind == TRANSPORT_UDP)
+		result = new UdpTransport();
+	else if (kind == TRANSPORT_UDP_RELAY)
+		result = new UdpTransport(MULTICAST_IP, MULTICAST_PORT, MULTICAST_RELAY_IP, MULTICAST_RELAY_PORT + pid);
+	else if (kind == TRANSPORT_SHM)
+		result = new ShmTransport();
+	else if (kind == TRANSPORT_LOOPBACK && loopback_bus)
+		result = new LoopbackTransport(*loopback_bus);
+	return result;
+}